@@ -42,6 +42,8 @@ public class Alpakit : ModuleRules
 				"Engine",
 				"Slate",
 				"SlateCore",
+				"Json",
+				"PakFile",
 				// ... add private dependencies that you statically link with here ...	
 			}
 			);
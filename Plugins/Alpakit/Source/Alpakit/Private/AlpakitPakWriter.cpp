@@ -0,0 +1,307 @@
+#include "AlpakitPakWriter.h"
+#include "IPlatformFilePak.h"
+#include "HAL/PlatformFilemanager.h"
+#include "HAL/FileManager.h"
+#include "Async/ParallelFor.h"
+#include "Misc/Compression.h"
+#include "Misc/SecureHash.h"
+#include "Misc/FileHelper.h"
+#include "Serialization/MemoryWriter.h"
+
+// Same block size UnrealPak uses by default
+static const int64 PakCompressionBlockSize = 64 * 1024;
+// Amount of files read and compressed concurrently before they are written into the pak
+static const int32 PakFilesPerBatch = 32;
+static const int32 PakVersion = FPakInfo::PakFile_Version_Latest;
+
+struct FPreparedPakFile
+{
+	FPakEntry Entry;
+	// File data exactly as it is stored in the pak after the entry header
+	TArray<uint8> StoredData;
+	FString Error;
+};
+
+static void TokenizePakListLine(const FString& Line, TArray<FString>& OutTokens)
+{
+	int32 Index = 0;
+	while (Index < Line.Len())
+	{
+		if (FChar::IsWhitespace(Line[Index]))
+		{
+			Index++;
+			continue;
+		}
+		if (Line[Index] == TEXT('"'))
+		{
+			int32 ClosingQuoteIndex = Line.Find(TEXT("\""), ESearchCase::CaseSensitive, ESearchDir::FromStart, Index + 1);
+			if (ClosingQuoteIndex == INDEX_NONE)
+				ClosingQuoteIndex = Line.Len();
+			OutTokens.Add(Line.Mid(Index + 1, ClosingQuoteIndex - Index - 1));
+			Index = ClosingQuoteIndex + 1;
+			continue;
+		}
+		const int32 TokenStart = Index;
+		while (Index < Line.Len() && !FChar::IsWhitespace(Line[Index]))
+			Index++;
+		OutTokens.Add(Line.Mid(TokenStart, Index - TokenStart));
+	}
+}
+
+bool FAlpakitPakWriter::ParsePakList(const TArray<FString>& PakListLines, TArray<FAlpakitPakInputFile>& OutFiles, FString& OutError)
+{
+	for (const FString& Line : PakListLines)
+	{
+		TArray<FString> Tokens;
+		TokenizePakListLine(Line, Tokens);
+		if (Tokens.Num() == 0)
+			continue;
+		if (Tokens.Num() < 2)
+		{
+			OutError = FString::Printf(TEXT("Malformed pak list line: %s"), *Line);
+			return false;
+		}
+		FAlpakitPakInputFile File{ Tokens[0], Tokens[1].Replace(TEXT("\\"), TEXT("/")), false, false };
+		for (int32 i = 2; i < Tokens.Num(); i++)
+		{
+			if (Tokens[i] == TEXT("-compress"))
+				File.bCompress = true;
+			else if (Tokens[i] == TEXT("-encrypt"))
+				File.bEncrypt = true;
+		}
+		OutFiles.Add(File);
+	}
+	return true;
+}
+
+FString FAlpakitPakWriter::GetMountPoint(const TArray<FAlpakitPakInputFile>& Files)
+{
+	if (Files.Num() == 0)
+		return TEXT("");
+	FString MountPoint = FPaths::GetPath(Files[0].DestinationPath) + TEXT("/");
+	for (const FAlpakitPakInputFile& File : Files)
+	{
+		while (!MountPoint.IsEmpty() && !File.DestinationPath.StartsWith(MountPoint))
+		{
+			// Strip trailing slash, then move to the parent directory
+			MountPoint = FPaths::GetPath(MountPoint.LeftChop(1));
+			if (!MountPoint.IsEmpty())
+				MountPoint += TEXT("/");
+		}
+	}
+	return MountPoint;
+}
+
+static void PrepareStoredData(const FAlpakitPakInputFile& File, uint32 CompressionMethodIndex, FPreparedPakFile& Out)
+{
+	TArray<uint8> FileData;
+	if (!FFileHelper::LoadFileToArray(FileData, *File.SourcePath))
+	{
+		Out.Error = FString::Printf(TEXT("Failed to read %s"), *File.SourcePath);
+		return;
+	}
+	FPakEntry& Entry = Out.Entry;
+	// Entry header inside of the pak is written without offset, same as UnrealPak does
+	Entry.Offset = 0;
+	Entry.UncompressedSize = FileData.Num();
+	Entry.CompressionMethodIndex = 0;
+
+	if (File.bCompress && FileData.Num() > 0)
+	{
+		const int32 NumBlocks = (int32)((FileData.Num() + PakCompressionBlockSize - 1) / PakCompressionBlockSize);
+		Entry.CompressionMethodIndex = CompressionMethodIndex;
+		Entry.CompressionBlockSize = (uint32)FMath::Min<int64>(PakCompressionBlockSize, FileData.Num());
+		Entry.CompressionBlocks.SetNum(NumBlocks);
+		// Block offsets are relative to the start of the entry header, so header size has to be known upfront
+		const int64 HeaderSize = Entry.GetSerializedSize(PakVersion);
+		const int32 MaxCompressedBlockSize = FCompression::CompressMemoryBound(NAME_Zlib, (int32)PakCompressionBlockSize);
+		bool bCompressionSucceeded = true;
+		for (int32 BlockIndex = 0; BlockIndex < NumBlocks; BlockIndex++)
+		{
+			const int64 BlockStart = BlockIndex * PakCompressionBlockSize;
+			const int32 BlockSize = (int32)FMath::Min<int64>(PakCompressionBlockSize, FileData.Num() - BlockStart);
+			const int32 StoredStart = Out.StoredData.Num();
+			int32 CompressedSize = MaxCompressedBlockSize;
+			Out.StoredData.AddUninitialized(MaxCompressedBlockSize);
+			if (!FCompression::CompressMemory(NAME_Zlib, Out.StoredData.GetData() + StoredStart, CompressedSize, FileData.GetData() + BlockStart, BlockSize))
+			{
+				bCompressionSucceeded = false;
+				break;
+			}
+			Out.StoredData.SetNum(StoredStart + CompressedSize, false);
+			Entry.CompressionBlocks[BlockIndex].CompressedStart = HeaderSize + StoredStart;
+			Entry.CompressionBlocks[BlockIndex].CompressedEnd = HeaderSize + StoredStart + CompressedSize;
+		}
+		// Store file as is if compression did not make it any smaller
+		if (bCompressionSucceeded && Out.StoredData.Num() < FileData.Num())
+		{
+			Entry.Size = Out.StoredData.Num();
+			FSHA1::HashBuffer(Out.StoredData.GetData(), Out.StoredData.Num(), Entry.Hash);
+			return;
+		}
+		Entry.CompressionMethodIndex = 0;
+		Entry.CompressionBlockSize = 0;
+		Entry.CompressionBlocks.Empty();
+	}
+	Out.StoredData = MoveTemp(FileData);
+	Entry.Size = Out.StoredData.Num();
+	FSHA1::HashBuffer(Out.StoredData.GetData(), Out.StoredData.Num(), Entry.Hash);
+}
+
+bool FAlpakitPakWriter::WritePak(const FString& PakFilePath, const TArray<FString>& PakListLines, FString& OutError)
+{
+	TArray<FAlpakitPakInputFile> Files;
+	if (!ParsePakList(PakListLines, Files, OutError))
+		return false;
+	bool bHasCompressedFiles = false;
+	for (const FAlpakitPakInputFile& File : Files)
+	{
+		if (File.bEncrypt)
+		{
+			OutError = TEXT("Encrypted files are not supported");
+			return false;
+		}
+		bHasCompressedFiles |= File.bCompress;
+	}
+	FString MountPoint = GetMountPoint(Files);
+
+	TUniquePtr<FArchive> PakWriter(IFileManager::Get().CreateFileWriter(*PakFilePath));
+	if (!PakWriter.IsValid())
+	{
+		OutError = FString::Printf(TEXT("Failed to open %s for writing"), *PakFilePath);
+		return false;
+	}
+	FPakInfo Info;
+	uint32 CompressionMethodIndex = 0;
+	if (bHasCompressedFiles)
+	{
+		// Index 0 of the compression methods is reserved for uncompressed entries
+		CompressionMethodIndex = Info.GetCompressionMethodIndex(NAME_Zlib);
+	}
+
+	TArray<TPair<FString, FPakEntry>> IndexEntries;
+	IndexEntries.Reserve(Files.Num());
+	for (int32 BatchStart = 0; BatchStart < Files.Num(); BatchStart += PakFilesPerBatch)
+	{
+		const int32 BatchSize = FMath::Min(PakFilesPerBatch, Files.Num() - BatchStart);
+		TArray<FPreparedPakFile> PreparedFiles;
+		PreparedFiles.SetNum(BatchSize);
+		ParallelFor(BatchSize, [&](int32 i)
+		{
+			PrepareStoredData(Files[BatchStart + i], CompressionMethodIndex, PreparedFiles[i]);
+		});
+		for (int32 i = 0; i < BatchSize; i++)
+		{
+			FPreparedPakFile& PreparedFile = PreparedFiles[i];
+			if (!PreparedFile.Error.IsEmpty())
+			{
+				OutError = PreparedFile.Error;
+				return false;
+			}
+			const int64 EntryOffset = PakWriter->Tell();
+			PreparedFile.Entry.Serialize(*PakWriter, PakVersion);
+			PakWriter->Serialize(PreparedFile.StoredData.GetData(), PreparedFile.StoredData.Num());
+			PreparedFile.Entry.Offset = EntryOffset;
+			IndexEntries.Add(TPair<FString, FPakEntry>(Files[BatchStart + i].DestinationPath.Mid(MountPoint.Len()), PreparedFile.Entry));
+		}
+	}
+
+	// Index is written after all of the files, followed by the pak info at the very end of the file
+	TArray<uint8> IndexData;
+	FMemoryWriter IndexWriter(IndexData);
+	IndexWriter << MountPoint;
+	int32 NumEntries = IndexEntries.Num();
+	IndexWriter << NumEntries;
+	for (TPair<FString, FPakEntry>& IndexEntry : IndexEntries)
+	{
+		IndexWriter << IndexEntry.Key;
+		IndexEntry.Value.Serialize(IndexWriter, PakVersion);
+	}
+	Info.IndexOffset = PakWriter->Tell();
+	Info.IndexSize = IndexData.Num();
+	FSHA1::HashBuffer(IndexData.GetData(), IndexData.Num(), Info.IndexHash);
+	PakWriter->Serialize(IndexData.GetData(), IndexData.Num());
+	Info.Serialize(*PakWriter, PakVersion);
+
+	const bool bWriteFailed = PakWriter->IsError();
+	if (!PakWriter->Close() || bWriteFailed)
+	{
+		OutError = FString::Printf(TEXT("Failed to write %s"), *PakFilePath);
+		return false;
+	}
+	return true;
+}
+
+// Reads stored data of the entry back and restores original file contents from it
+static bool ReadPakEntry(FPakFile& PakFile, const FPakEntry& Entry, TAcquirePakReaderFunction& AcquirePakReader, TArray<uint8>& OutData)
+{
+	OutData.SetNumUninitialized(Entry.UncompressedSize);
+	if (Entry.CompressionMethodIndex == 0)
+	{
+		FPakFileHandle<FPakReaderPolicy<>> EntryHandle(PakFile, Entry, AcquirePakReader, true);
+		return EntryHandle.Read(OutData.GetData(), OutData.Num());
+	}
+	// Compressed reader policy of the engine is private to the pak module, so blocks are inflated here
+	const FName CompressionMethod = PakFile.GetInfo().GetCompressionMethod(Entry.CompressionMethodIndex);
+	FArchive* PakReader = AcquirePakReader();
+	TArray<uint8> CompressedBlock;
+	for (int32 BlockIndex = 0; BlockIndex < Entry.CompressionBlocks.Num(); BlockIndex++)
+	{
+		const FPakCompressedBlock& Block = Entry.CompressionBlocks[BlockIndex];
+		const int64 BlockStart = BlockIndex * (int64)Entry.CompressionBlockSize;
+		const int32 BlockSize = (int32)FMath::Min<int64>(Entry.CompressionBlockSize, Entry.UncompressedSize - BlockStart);
+		if (BlockSize <= 0)
+			return false;
+		// Block offsets are relative to the start of the entry header
+		CompressedBlock.SetNumUninitialized(Block.CompressedEnd - Block.CompressedStart);
+		PakReader->Seek(Entry.Offset + Block.CompressedStart);
+		PakReader->Serialize(CompressedBlock.GetData(), CompressedBlock.Num());
+		if (PakReader->IsError() || !FCompression::UncompressMemory(CompressionMethod, OutData.GetData() + BlockStart, BlockSize, CompressedBlock.GetData(), CompressedBlock.Num()))
+			return false;
+	}
+	return true;
+}
+
+bool FAlpakitPakWriter::VerifyPak(const FString& PakFilePath, const TArray<FString>& PakListLines, FString& OutError)
+{
+	TArray<FAlpakitPakInputFile> Files;
+	if (!ParsePakList(PakListLines, Files, OutError))
+		return false;
+
+	// Pak is read directly on top of the regular platform file and never mounted, so verification
+	// does not touch the pak platform file of the editor or any of the global pak delegates
+	IPlatformFile& LowerLevelFile = FPlatformFileManager::Get().GetPlatformFile();
+	FPakFile PakFile(&LowerLevelFile, *PakFilePath, false);
+	if (!PakFile.IsValid())
+	{
+		OutError = FString::Printf(TEXT("Engine pak reader failed to open %s"), *PakFilePath);
+		return false;
+	}
+	TAcquirePakReaderFunction AcquirePakReader = [&PakFile, &LowerLevelFile]() { return PakFile.GetSharedReader(&LowerLevelFile); };
+
+	const FString MountPoint = GetMountPoint(Files);
+	for (const FAlpakitPakInputFile& File : Files)
+	{
+		TArray<uint8> SourceData;
+		if (!FFileHelper::LoadFileToArray(SourceData, *File.SourcePath))
+		{
+			OutError = FString::Printf(TEXT("Failed to read %s"), *File.SourcePath);
+			return false;
+		}
+		// Lookups go through the mount point the pak reader has read from the pak itself
+		const FString PakPath = PakFile.GetMountPoint() + File.DestinationPath.Mid(MountPoint.Len());
+		FPakEntry Entry;
+		if (PakFile.Find(PakPath, &Entry) != FPakFile::EFindResult::Found || Entry.UncompressedSize != SourceData.Num())
+		{
+			OutError = FString::Printf(TEXT("%s is missing or has wrong size in the pak"), *File.DestinationPath);
+			return false;
+		}
+		TArray<uint8> PakData;
+		if (!ReadPakEntry(PakFile, Entry, AcquirePakReader, PakData) || FMemory::Memcmp(PakData.GetData(), SourceData.GetData(), SourceData.Num()) != 0)
+		{
+			OutError = FString::Printf(TEXT("%s contents in the pak do not match the cooked file"), *File.DestinationPath);
+			return false;
+		}
+	}
+	return true;
+}
@@ -2,4 +2,8 @@
 
 UAlpakitSettings::UAlpakitSettings(const FObjectInitializer& ObjectInitializer) : Super(ObjectInitializer)
 {
+	MaxParallelPakJobs = FMath::Max(1, FPlatformMisc::NumberOfCores() / 2);
+	ForceRepack = false;
+	UseDirectPakWriter = false;
+	VerifyDirectPaks = true;
 }
\ No newline at end of file
@@ -3,6 +3,10 @@
 #include "Developer/DesktopPlatform/Public/DesktopPlatformModule.h"
 #include "Editor/UATHelper/Public/IUATHelperModule.h"
 #include "PropertyEditorModule.h"
+#include "Async/ParallelFor.h"
+#include "Misc/SecureHash.h"
+#include "Json.h"
+#include "AlpakitPakWriter.h"
 
 void SAlpakaWidget::Construct(const FArguments& InArgs)
 {
@@ -45,6 +49,13 @@ void SAlpakaWidget::Construct(const FArguments& InArgs)
 							DetailsView.ToSharedRef()
 						]
 				]
+			+ SVerticalBox::Slot()
+				.AutoHeight()
+				.Padding(3.0f)
+				[
+					SAssignNew(ReportText, STextBlock)
+					.AutoWrapText(true)
+				]
 			+ SVerticalBox::Slot()
 				.AutoHeight()
 				.HAlign(HAlign_Right)
@@ -135,8 +146,154 @@ void ClearAutomationLogForVersionCheck() {
 	}	
 }
 
+// Returns path of the cooked file referenced by the pak list line, which is the first (optionally quoted) token of it
+FString GetPakListSourcePath(const FString& PakListLine)
+{
+	FString Line = PakListLine.TrimStartAndEnd();
+	if (Line.StartsWith(TEXT("\"")))
+	{
+		int32 ClosingQuoteIndex = Line.Find(TEXT("\""), ESearchCase::CaseSensitive, ESearchDir::FromStart, 1);
+		return ClosingQuoteIndex == INDEX_NONE ? Line.Mid(1) : Line.Mid(1, ClosingQuoteIndex - 1);
+	}
+	int32 SpaceIndex;
+	return Line.FindChar(' ', SpaceIndex) ? Line.Left(SpaceIndex) : Line;
+}
+
+// Builds manifest of the mod pak contents, consisting of the hash of every cooked file followed by it's pak list line
+// Pak only needs to be rebuilt when the manifest is different from the one it was built with
+FString BuildModPakManifest(const TArray<FString>& ModFilesToPak, int64& OutTotalBytes)
+{
+	TArray<FString> ManifestEntries;
+	TArray<int64> FileSizes;
+	ManifestEntries.SetNum(ModFilesToPak.Num());
+	FileSizes.SetNumZeroed(ModFilesToPak.Num());
+	ParallelFor(ModFilesToPak.Num(), [&](int32 i)
+	{
+		const FString SourcePath = GetPakListSourcePath(ModFilesToPak[i]);
+		const FMD5Hash FileHash = FMD5Hash::HashFile(*SourcePath);
+		FileSizes[i] = FMath::Max<int64>(0, IFileManager::Get().FileSize(*SourcePath));
+		ManifestEntries[i] = FString::Printf(TEXT("%s %s"), *LexToString(FileHash), *ModFilesToPak[i].TrimStartAndEnd());
+	});
+	OutTotalBytes = 0;
+	for (int64 FileSize : FileSizes)
+		OutTotalBytes += FileSize;
+	ManifestEntries.Sort();
+	return FString::Join(ManifestEntries, TEXT("\n"));
+}
+
+FString GetModPakManifestPath(const FString& PakName)
+{
+	return FPaths::ConvertRelativePathToFull(FPaths::ProjectSavedDir() / TEXT("Alpakit") / FString::Printf(TEXT("%s.manifest"), *PakName));
+}
+
+struct FModPakJob
+{
+	FString ModName;
+	FString PakName;
+	FString PakFilePath;
+	FString PakListPath;
+	TArray<FString> PakListLines;
+	FString Manifest;
+	int64 InputBytes;
+	double StartTime;
+	TSharedPtr<FMonitoredProcess> PakingProcess;
+};
+
+// Single measured stage of the Alpakit run, stages of the individual mods have ModName set
+struct FAlpakitStage
+{
+	FString Name;
+	FString ModName;
+	double Seconds;
+	int64 InputBytes;
+	int64 OutputBytes;
+	bool bSkipped;
+};
+
+class FAlpakitReport
+{
+public:
+	TArray<FAlpakitStage> Stages;
+	double StageStartTime = FPlatformTime::Seconds();
+
+	// Records stage which started at the end of the previous one
+	void EndStage(const FString& Name, int64 InputBytes = 0, int64 OutputBytes = 0)
+	{
+		const double CurrentTime = FPlatformTime::Seconds();
+		Stages.Add(FAlpakitStage{ Name, TEXT(""), CurrentTime - StageStartTime, InputBytes, OutputBytes, false });
+		StageStartTime = CurrentTime;
+	}
+
+	void AddModStage(const FString& Name, const FString& ModName, double Seconds, int64 InputBytes, int64 OutputBytes, bool bSkipped = false)
+	{
+		Stages.Add(FAlpakitStage{ Name, ModName, Seconds, InputBytes, OutputBytes, bSkipped });
+	}
+
+	// Run wall time. Stages of the individual mods run inside of the run stages, so only run stages are summed
+	double GetTotalSeconds() const
+	{
+		double TotalSeconds = 0.0;
+		for (const FAlpakitStage& Stage : Stages)
+			if (Stage.ModName.IsEmpty())
+				TotalSeconds += Stage.Seconds;
+		return TotalSeconds;
+	}
+
+	FString ToSummaryText() const
+	{
+		TArray<FString> Lines;
+		for (const FAlpakitStage& Stage : Stages)
+		{
+			FString Line = Stage.ModName.IsEmpty() ? Stage.Name : FString::Printf(TEXT("%s %s"), *Stage.Name, *Stage.ModName);
+			if (Stage.bSkipped)
+				Line += TEXT(": up to date");
+			else
+				Line += FString::Printf(TEXT(": %.2fs"), Stage.Seconds);
+			const int64 Bytes = FMath::Max(Stage.InputBytes, Stage.OutputBytes);
+			if (Bytes > 0)
+			{
+				Line += FString::Printf(TEXT(", %.2f MB"), Bytes / (1024.0 * 1024.0));
+				if (Stage.Seconds > 0.0)
+					Line += FString::Printf(TEXT(" (%.2f MB/s)"), Bytes / (1024.0 * 1024.0) / Stage.Seconds);
+			}
+			Lines.Add(Line);
+		}
+		Lines.Add(FString::Printf(TEXT("Total: %.2fs"), GetTotalSeconds()));
+		return FString::Join(Lines, TEXT("\n"));
+	}
+
+	void WriteJson(const FString& FilePath) const
+	{
+		TSharedRef<FJsonObject> ReportJson = MakeShareable(new FJsonObject());
+		ReportJson->SetStringField(TEXT("Date"), FDateTime::UtcNow().ToIso8601());
+		ReportJson->SetNumberField(TEXT("TotalSeconds"), GetTotalSeconds());
+		TArray<TSharedPtr<FJsonValue>> StagesJson;
+		for (const FAlpakitStage& Stage : Stages)
+		{
+			TSharedRef<FJsonObject> StageJson = MakeShareable(new FJsonObject());
+			StageJson->SetStringField(TEXT("Name"), Stage.Name);
+			if (!Stage.ModName.IsEmpty())
+				StageJson->SetStringField(TEXT("Mod"), Stage.ModName);
+			StageJson->SetNumberField(TEXT("Seconds"), Stage.Seconds);
+			StageJson->SetNumberField(TEXT("InputBytes"), Stage.InputBytes);
+			StageJson->SetNumberField(TEXT("OutputBytes"), Stage.OutputBytes);
+			if (Stage.bSkipped)
+				StageJson->SetBoolField(TEXT("Skipped"), true);
+			StagesJson.Add(MakeShareable(new FJsonValueObject(StageJson)));
+		}
+		ReportJson->SetArrayField(TEXT("Stages"), StagesJson);
+		FString ReportString;
+		TSharedRef<TJsonWriter<>> Writer = TJsonWriterFactory<>::Create(&ReportString);
+		FJsonSerializer::Serialize(ReportJson, Writer);
+		FFileHelper::SaveStringToFile(ReportString, *FilePath);
+	}
+};
+
 void SAlpakaWidget::CookDone(FString result, double runtime)
 {
+	// Cook time is reported by the UAT task, everything else is measured here
+	FAlpakitReport Report;
+	Report.Stages.Add(FAlpakitStage{ TEXT("Cook"), TEXT(""), runtime, 0, 0, false });
 	if (result.Equals("completed", ESearchCase::IgnoreCase))
 	{
 		// Cooking was successful
@@ -160,85 +317,189 @@ void SAlpakaWidget::CookDone(FString result, double runtime)
 		TArray<FString> FilesToPak;
 		FFileHelper::LoadFileToStringArray(FilesToPak, *PakListPath);
 
-		for (FAlpakitMod mod : Settings->Mods)
+		// Split cooked assets between the mods in a single pass over the list
+		FString contentFolder = FPaths::ConvertRelativePathToFull(FPaths::ProjectDir() / FString::Printf(TEXT("Saved/Cooked/WindowsNoEditor/%s/Content"), FApp::GetProjectName()));
+		FString factoryGameCookFolder = (contentFolder / TEXT("FactoryGame")).Replace(L"/", L"\\");
+		TArray<FString> ModCookFolders;
+		TArray<TArray<FString>> ModOverwritePrefixes;
+		TArray<TArray<FString>> ModFilesToPak;
+		ModFilesToPak.SetNum(Settings->Mods.Num());
+		for (const FAlpakitMod& mod : Settings->Mods)
 		{
-			// Choose from the cooked list only the current mod assets
-			TArray<FString> ModFilesToPak;
-			FString contentFolder = FPaths::ConvertRelativePathToFull(FPaths::ProjectDir() / FString::Printf(TEXT("Saved/Cooked/WindowsNoEditor/%s/Content"), FApp::GetProjectName()));
 			FString modCookFolder = (contentFolder / FString::Printf(TEXT("%s"), *mod.Name)).Replace(L"/", L"\\");
 			UE_LOG(LogTemp, Log, TEXT("%s"), *modCookFolder);
-			for (FString file : FilesToPak)
+			ModCookFolders.Add(modCookFolder);
+			ModOverwritePrefixes.AddDefaulted();
+			TArray<FString>& OverwritePrefixes = ModOverwritePrefixes.Last();
+			for (const FString& path : mod.OverwritePaths)
+			{
+				FString cookedFilePath = (contentFolder / path.RightChop(6)).Replace(L"/", L"\\"); // Should cut /Game/ from the path. Pls don't cause issues.
+				OverwritePrefixes.Add(FString::Printf(TEXT("%s.uasset"), *cookedFilePath));
+				OverwritePrefixes.Add(FString::Printf(TEXT("%s.uexp"), *cookedFilePath));
+			}
+		}
+		for (const FString& file : FilesToPak)
+		{
+			const FString trimmedFile = file.TrimQuotes();
+			const bool bIsFactoryGameFile = trimmedFile.StartsWith(factoryGameCookFolder);
+			for (int32 i = 0; i < Settings->Mods.Num(); i++)
 			{
-				if (file.TrimQuotes().StartsWith(modCookFolder))
-					ModFilesToPak.Add(file);
-				else if (file.TrimQuotes().StartsWith((contentFolder / TEXT("FactoryGame")).Replace(L"/", L"\\")))
+				if (trimmedFile.StartsWith(ModCookFolders[i]))
+					ModFilesToPak[i].Add(file);
+				else if (bIsFactoryGameFile)
 				{
-					for (FString path : mod.OverwritePaths)
+					for (const FString& overwritePrefix : ModOverwritePrefixes[i])
 					{
-						FString cookedFilePath = (contentFolder / path.RightChop(6)).Replace(L"/", L"\\"); // Should cut /Game/ from the path. Pls don't cause issues.
-						FString uassetPath = FString::Printf(TEXT("%s.uasset"), *cookedFilePath);
-						FString uexpPath = FString::Printf(TEXT("%s.uexp"), *cookedFilePath);
-						if (file.TrimQuotes().StartsWith(uassetPath) || file.TrimQuotes().StartsWith(uexpPath))
-							ModFilesToPak.Add(file);
+						if (trimmedFile.StartsWith(overwritePrefix))
+							ModFilesToPak[i].Add(file);
 					}
 				}
 			}
+		}
 
-			FString pakName = FString::Printf(TEXT("%s%s"), *mod.Name, mod.OverwritePaths.Num() == 0 ? TEXT("") : TEXT("_p"));
+		IPlatformFile& PlatformFile = FPlatformFileManager::Get().GetPlatformFile();
+		FString modPakFolder = FPaths::ConvertRelativePathToFull(FPaths::ProjectDir() / L"Mods");
+		if (!PlatformFile.DirectoryExists(*modPakFolder))
+			PlatformFile.CreateDirectory(*modPakFolder);
 
-			// Save it for UnrealPak.exe
-			FString ModPakListPath;
+		const auto CopyModToGame = [this, &PlatformFile, &Report](const FModPakJob& Job)
+		{
+			if (Settings->CopyModsToGame) {
+				// Copy to Satisfactory Content/Paks folder
+				const double CopyStartTime = FPlatformTime::Seconds();
+				PlatformFile.CopyFile(*FPaths::ConvertRelativePathToFull(Settings->SatisfactoryGamePath.Path / TEXT("mods") / FString::Printf(L"%s.pak", *Job.PakName)), *Job.PakFilePath);
+				const int64 PakSize = FMath::Max<int64>(0, PlatformFile.FileSize(*Job.PakFilePath));
+				Report.AddModStage(TEXT("Copy"), Job.ModName, FPlatformTime::Seconds() - CopyStartTime, PakSize, PakSize);
+				UE_LOG(LogTemp, Log, TEXT("Copied %s to game dir"), *Job.ModName);
+			}
+		};
+
+		TArray<FModPakJob> PendingJobs;
+		TArray<FModPakJob> UpToDateJobs;
+		int64 TotalModBytes = 0;
+		for (int32 i = 0; i < Settings->Mods.Num(); i++)
+		{
+			const FAlpakitMod& mod = Settings->Mods[i];
+			FModPakJob Job;
+			Job.ModName = mod.Name;
+			Job.PakName = FString::Printf(TEXT("%s%s"), *mod.Name, mod.OverwritePaths.Num() == 0 ? TEXT("") : TEXT("_p"));
+			Job.PakFilePath = FPaths::ConvertRelativePathToFull(FPaths::ProjectDir() / L"Mods" / FString::Printf(L"%s.pak", *Job.PakName));
+
+			// Skip mods which contents did not change since their pak was built
+			Job.Manifest = BuildModPakManifest(ModFilesToPak[i], Job.InputBytes);
+			TotalModBytes += Job.InputBytes;
+			FString PreviousManifest;
+			if (!Settings->ForceRepack && PlatformFile.FileExists(*Job.PakFilePath) &&
+				FFileHelper::LoadFileToString(PreviousManifest, *GetModPakManifestPath(Job.PakName)) && PreviousManifest == Job.Manifest)
+			{
+				UE_LOG(LogTemp, Log, TEXT("%s is up to date, skipping packing"), *mod.Name);
+				UpToDateJobs.Add(Job);
+				continue;
+			}
 
+			// Save it for UnrealPak.exe
 			if (automationLogVersion == 0) {
-				ModPakListPath = GetPakListPathV1(pakName);
+				Job.PakListPath = GetPakListPathV1(Job.PakName);
 			}
-			else if (automationLogVersion == 1) {
-				ModPakListPath = GetPakListPathV2(pakName);
+			else {
+				Job.PakListPath = GetPakListPathV2(Job.PakName);
 			}
-			else
-				return;
-
-			FFileHelper::SaveStringArrayToFile(ModFilesToPak, *ModPakListPath);
-			
-			// Setup the pak file path
-			IPlatformFile& PlatformFile = FPlatformFileManager::Get().GetPlatformFile();
-			FString modPakFolder = FPaths::ConvertRelativePathToFull(FPaths::ProjectDir() / L"Mods");
-			if (!PlatformFile.DirectoryExists(*modPakFolder))
-				PlatformFile.CreateDirectory(*modPakFolder);
-			FString pakFilePath = FPaths::ConvertRelativePathToFull(FPaths::ProjectDir() / L"Mods" / FString::Printf(L"%s.pak", *pakName));
-			
-			// Run the paker and wait
-			FString FullCommandLine = FString::Printf(TEXT("/c \"\"%s\" %s\""), *UPakPath, *FString::Printf(TEXT("\"%s\" -create=\"%s\""), *pakFilePath, *ModPakListPath));
-			TSharedPtr<FMonitoredProcess> PakingProcess = MakeShareable(new FMonitoredProcess(CmdExe, FullCommandLine, true));
-			PakingProcess->OnOutput().BindLambda([this, mod](FString output) { UE_LOG(LogTemp, Log, TEXT("Paking %s: %s"), *mod.Name, *output); });
-			PakingProcess->Launch();
-
-			UE_LOG(LogTemp, Log, TEXT("Packing %s"), *mod.Name);
-			while (PakingProcess->Update())
-				FPlatformProcess::Sleep(0.03);
-			UE_LOG(LogTemp, Log, TEXT("Packed %s"), *mod.Name);
+			FFileHelper::SaveStringArrayToFile(ModFilesToPak[i], *Job.PakListPath);
+			Job.PakListLines = ModFilesToPak[i];
+			PendingJobs.Add(Job);
+		}
+		Report.EndStage(TEXT("Pak list generation"), TotalModBytes);
+		for (const FModPakJob& Job : UpToDateJobs)
+		{
+			Report.AddModStage(TEXT("Pak"), Job.ModName, 0.0, Job.InputBytes, FMath::Max<int64>(0, PlatformFile.FileSize(*Job.PakFilePath)), true);
+			CopyModToGame(Job);
+		}
 
-			if (Settings->CopyModsToGame) {
-				// Copy to Satisfactory Content/Paks folder
-				PlatformFile.CopyFile(*FPaths::ConvertRelativePathToFull(Settings->SatisfactoryGamePath.Path / TEXT("mods") / FString::Printf(L"%s.pak", *pakName)), *pakFilePath);
-				UE_LOG(LogTemp, Log, TEXT("Copied %s to game dir"), *mod.Name);
+		const auto OnModPacked = [&PlatformFile, &Report, &CopyModToGame](const FModPakJob& Job)
+		{
+			UE_LOG(LogTemp, Log, TEXT("Packed %s"), *Job.ModName);
+			Report.AddModStage(TEXT("Pak"), Job.ModName, FPlatformTime::Seconds() - Job.StartTime, Job.InputBytes, FMath::Max<int64>(0, PlatformFile.FileSize(*Job.PakFilePath)));
+			FFileHelper::SaveStringToFile(Job.Manifest, *GetModPakManifestPath(Job.PakName));
+			CopyModToGame(Job);
+		};
+
+		if (Settings->UseDirectPakWriter)
+		{
+			// Write paks in-process, mods the direct writer cannot handle are left for UnrealPak
+			TArray<FModPakJob> UnrealPakJobs;
+			for (FModPakJob& Job : PendingJobs)
+			{
+				Job.StartTime = FPlatformTime::Seconds();
+				FString PakError;
+				bool bPacked = FAlpakitPakWriter::WritePak(Job.PakFilePath, Job.PakListLines, PakError);
+				if (bPacked && Settings->VerifyDirectPaks)
+					bPacked = FAlpakitPakWriter::VerifyPak(Job.PakFilePath, Job.PakListLines, PakError);
+				if (bPacked)
+					OnModPacked(Job);
+				else
+				{
+					UE_LOG(LogTemp, Warning, TEXT("Direct packing of %s failed, falling back to UnrealPak: %s"), *Job.ModName, *PakError);
+					UnrealPakJobs.Add(Job);
+				}
 			}
+			PendingJobs = MoveTemp(UnrealPakJobs);
 		}
-		if (Settings->StartGame)
+
+		// Run the pakers, keeping at most MaxParallelPakJobs of them running at once
+		const int32 MaxRunningJobs = FMath::Max(1, Settings->MaxParallelPakJobs);
+		TArray<FModPakJob> RunningJobs;
+		while (PendingJobs.Num() > 0 || RunningJobs.Num() > 0)
 		{
-			FString gamePath = FString::Printf(TEXT("\"%s\""), *FPaths::ConvertRelativePathToFull(Settings->SatisfactoryGamePath.Path / L"FactoryGame/Binaries/Win64/FactoryGame-Win64-Shipping.exe").Replace(L"/", L"\\"));
-			int pathLength = gamePath.Len();
-			char SatisfactoryPath[WINDOWS_MAX_PATH + 5];
-			for (int i = 0; i < pathLength; i++)
+			while (RunningJobs.Num() < MaxRunningJobs && PendingJobs.Num() > 0)
+			{
+				FModPakJob Job = PendingJobs[0];
+				PendingJobs.RemoveAt(0);
+				FString FullCommandLine = FString::Printf(TEXT("/c \"\"%s\" %s\""), *UPakPath, *FString::Printf(TEXT("\"%s\" -create=\"%s\""), *Job.PakFilePath, *Job.PakListPath));
+				Job.PakingProcess = MakeShareable(new FMonitoredProcess(CmdExe, FullCommandLine, true));
+				const FString ModName = Job.ModName;
+				Job.PakingProcess->OnOutput().BindLambda([ModName](FString output) { UE_LOG(LogTemp, Log, TEXT("Paking %s: %s"), *ModName, *output); });
+				Job.StartTime = FPlatformTime::Seconds();
+				Job.PakingProcess->Launch();
+				UE_LOG(LogTemp, Log, TEXT("Packing %s"), *Job.ModName);
+				RunningJobs.Add(Job);
+			}
+			for (int32 i = RunningJobs.Num() - 1; i >= 0; i--)
 			{
-				SatisfactoryPath[i] = gamePath[i];
-				SatisfactoryPath[i + 1] = '\000';
+				const FModPakJob& Job = RunningJobs[i];
+				if (Job.PakingProcess->Update())
+					continue;
+				if (Job.PakingProcess->GetReturnCode() == 0)
+					OnModPacked(Job);
+				else
+				{
+					UE_LOG(LogTemp, Error, TEXT("Packing %s failed with exit code %d"), *Job.ModName, Job.PakingProcess->GetReturnCode());
+					PlatformFile.DeleteFile(*GetModPakManifestPath(Job.PakName));
+				}
+				RunningJobs.RemoveAt(i);
 			}
-			system(SatisfactoryPath);
+			if (RunningJobs.Num() > 0)
+				FPlatformProcess::Sleep(0.03);
+		}
+		// Wall time of the packing stage, individual mods are packed concurrently
+		Report.EndStage(TEXT("Packing"));
+		if (Settings->StartGame)
+		{
+			// Game is started detached, so the launch stage only measures the process creation
+			FString gamePath = FPaths::ConvertRelativePathToFull(Settings->SatisfactoryGamePath.Path / L"FactoryGame/Binaries/Win64/FactoryGame-Win64-Shipping.exe").Replace(L"/", L"\\");
+			FProcHandle GameProcess = FPlatformProcess::CreateProc(*gamePath, TEXT(""), true, false, false, nullptr, 0, nullptr, nullptr);
+			if (!GameProcess.IsValid())
+				UE_LOG(LogTemp, Error, TEXT("Failed to start the game at %s"), *gamePath);
+			FPlatformProcess::CloseProc(GameProcess);
+			Report.EndStage(TEXT("Launch"));
 		}
 	}
 	else
 		UE_LOG(LogTemp, Error, TEXT("Error while running Aplakit. Cooking returned: %s"), *result);
+
+	const FString ReportPath = FPaths::ConvertRelativePathToFull(FPaths::ProjectSavedDir() / TEXT("Alpakit") / TEXT("AlpakitReport.json"));
+	Report.WriteJson(ReportPath);
+	ReportText->SetText(FText::FromString(Report.ToSummaryText()));
+	UE_LOG(LogTemp, Log, TEXT("Alpakit report written to %s"), *ReportPath);
 	AlpakitButton.Get()->SetEnabled(true);
 }
 
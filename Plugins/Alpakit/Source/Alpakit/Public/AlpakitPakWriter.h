@@ -0,0 +1,39 @@
+#pragma once
+
+#include "CoreMinimal.h"
+
+/** Single file of the pak list, in the UnrealPak response file format: "Source" "Destination" [-compress] [-encrypt] */
+struct FAlpakitPakInputFile
+{
+	FString SourcePath;
+	FString DestinationPath;
+	bool bCompress;
+	bool bEncrypt;
+};
+
+/**
+ * Writes pak files in-process instead of spawning UnrealPak for every mod
+ * Files are read and compressed on the thread pool in small batches and written into the pak as soon as
+ * the batch is ready, so only a few files are kept in memory at once. Pak layout and entry serialization
+ * are done by the engine pak structures, so the result is readable by the regular pak platform file
+ * Encryption and signing are not supported, WritePak fails for such pak lists so the caller can fall back to UnrealPak
+ */
+class FAlpakitPakWriter
+{
+public:
+	/** Parses pak list lines, returns false if any of them is malformed */
+	static bool ParsePakList(const TArray<FString>& PakListLines, TArray<FAlpakitPakInputFile>& OutFiles, FString& OutError);
+
+	/** Returns mount point of the pak containing given files, which is the deepest directory containing all of them */
+	static FString GetMountPoint(const TArray<FAlpakitPakInputFile>& Files);
+
+	/** Writes pak with the files from the pak list, returns false and fills OutError if it fails */
+	static bool WritePak(const FString& PakFilePath, const TArray<FString>& PakListLines, FString& OutError);
+
+	/**
+	 * Opens written pak with the engine pak reader and reads every file of the pak list back,
+	 * comparing it byte by byte with the cooked source file
+	 * Pak is never mounted, so verification has no effect on the pak platform file or pak delegates
+	 */
+	static bool VerifyPak(const FString& PakFilePath, const TArray<FString>& PakListLines, FString& OutError);
+};
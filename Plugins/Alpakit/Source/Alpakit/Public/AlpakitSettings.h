@@ -39,4 +39,20 @@ public:
 	UPROPERTY(EditAnywhere, config, Category = Config)
 	bool CopyModsToGame;
 
+	/** How many mods can be packed by UnrealPak at the same time */
+	UPROPERTY(EditAnywhere, config, Category = Config, meta = (ClampMin = 1))
+	int32 MaxParallelPakJobs;
+
+	/** Repack all mods, even if their cooked contents did not change since the last packing */
+	UPROPERTY(EditAnywhere, config, Category = Config)
+	bool ForceRepack;
+
+	/** Write paks directly from the editor instead of running UnrealPak, falls back to UnrealPak if it fails */
+	UPROPERTY(EditAnywhere, config, Category = Config)
+	bool UseDirectPakWriter;
+
+	/** Read every directly written pak back with the engine pak reader and compare it with the cooked files */
+	UPROPERTY(EditAnywhere, config, Category = Config, meta = (EditCondition = "UseDirectPakWriter"))
+	bool VerifyDirectPaks;
+
 };
\ No newline at end of file
@@ -28,6 +28,8 @@ public:
 	// UI
 	TSharedPtr<SButton> AlpakitButton;
 	TSharedPtr<SButton> SaveSettingsButton;
+	/** Stage timings of the last Alpakit run */
+	TSharedPtr<STextBlock> ReportText;
 
 	// Bindings
 	UAlpakitSettings* Settings;
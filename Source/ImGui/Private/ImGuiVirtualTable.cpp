@@ -0,0 +1,332 @@
+// Distributed under the MIT License (MIT) (see accompanying LICENSE file)
+
+#include "ImGuiPrivatePCH.h"
+
+#include "ImGuiVirtualTable.h"
+
+#include <Async/Async.h>
+
+
+// Copy of the values of one column for the snapshot data version. Once all rows are copied it is never changed again,
+// so queries running on worker threads can share it.
+struct FImGuiTableColumnSnapshot
+{
+	TArray<double> Numbers;
+	TArray<FString> Texts;
+	int32 NumCopiedRows = 0;
+};
+
+namespace
+{
+	// Sorts row indices by keys indexed by row. Ties are broken by row index, so the order is stable between queries.
+	template<typename KeyType, typename LessType>
+	void SortRows(TArray<int32>& Rows, const TArray<KeyType>& Keys, bool bAscending, LessType Less)
+	{
+		Rows.Sort([&Keys, bAscending, &Less](int32 A, int32 B)
+		{
+			if (Less(Keys[A], Keys[B]))
+			{
+				return bAscending;
+			}
+			if (Less(Keys[B], Keys[A]))
+			{
+				return !bAscending;
+			}
+			return A < B;
+		});
+	}
+
+	// Copying at most this many cells per frame keeps the game thread responsive even for large tables.
+	constexpr int32 MaxSnapshotCellsPerFrame = 32768;
+
+	// Cell values needed to filter and sort rows. Column snapshots are complete and never change once a query starts, so
+	// the query running on a worker thread never reads the provider, which can change or shrink in the meantime.
+	struct FQueryInput
+	{
+		int32 NumRows = 0;
+		FString Filter;
+		TArray<TSharedRef<const FImGuiTableColumnSnapshot, ESPMode::ThreadSafe>> FilterColumns;
+		TSharedPtr<const FImGuiTableColumnSnapshot, ESPMode::ThreadSafe> SortKeys;
+		bool bSortAscending = true;
+	};
+
+	// Runs on a worker thread and only reads the copied cell values.
+	TArray<int32> QueryRows(const FQueryInput& Input)
+	{
+		TArray<int32> Rows;
+		Rows.Reserve(Input.NumRows);
+
+		for (int32 Row = 0; Row < Input.NumRows; Row++)
+		{
+			bool bPassesFilter = Input.Filter.IsEmpty();
+			for (const TSharedRef<const FImGuiTableColumnSnapshot, ESPMode::ThreadSafe>& Column : Input.FilterColumns)
+			{
+				if (Column->Texts[Row].Contains(Input.Filter))
+				{
+					bPassesFilter = true;
+					break;
+				}
+			}
+			if (bPassesFilter)
+			{
+				Rows.Add(Row);
+			}
+		}
+
+		if (Input.SortKeys.IsValid() && Input.SortKeys->Numbers.Num() > 0)
+		{
+			SortRows(Rows, Input.SortKeys->Numbers, Input.bSortAscending, [](double A, double B) { return A < B; });
+		}
+		else if (Input.SortKeys.IsValid() && Input.SortKeys->Texts.Num() > 0)
+		{
+			SortRows(Rows, Input.SortKeys->Texts, Input.bSortAscending, [](const FString& A, const FString& B) { return A.Compare(B, ESearchCase::IgnoreCase) < 0; });
+		}
+
+		return Rows;
+	}
+}
+
+FString IImGuiTableDataProvider::FormatCell(int32 Column, int32 Row) const
+{
+	return (GetColumnType(Column) == EImGuiTableColumnType::Number) ? FString::SanitizeFloat(GetNumber(Column, Row)) : GetText(Column, Row);
+}
+
+FImGuiVirtualTable::FImGuiVirtualTable(const FString& InId, const TSharedRef<IImGuiTableDataProvider, ESPMode::ThreadSafe>& InProvider)
+	: Id(InId)
+	, Provider(InProvider)
+{
+	FilterBuffer[0] = '\0';
+}
+
+void FImGuiVirtualTable::SetSortColumn(int32 Column, bool bAscending)
+{
+	SortColumn = Column;
+	bSortAscending = bAscending;
+	bQueryDirty = true;
+}
+
+void FImGuiVirtualTable::SetFilter(const FString& Filter)
+{
+	FCStringAnsi::Strncpy(FilterBuffer, TCHAR_TO_UTF8(*Filter), ARRAY_COUNT(FilterBuffer));
+	bQueryDirty = true;
+}
+
+void FImGuiVirtualTable::Draw(float Height)
+{
+	const int32 NumColumns = Provider->GetNumColumns();
+	if (NumColumns <= 0)
+	{
+		return;
+	}
+
+	ImGui::PushID(TCHAR_TO_UTF8(*Id));
+
+	if (ImGui::InputText("Filter", FilterBuffer, ARRAY_COUNT(FilterBuffer)))
+	{
+		bQueryDirty = true;
+	}
+
+	UpdateQuery();
+
+	const int32 NumRows = Provider->GetNumRows();
+	ImGui::SameLine();
+	ImGui::TextDisabled("%d / %d rows%s", DisplayedRows.Num(), NumRows, (PendingQuery.IsValid() || bQueryDirty) ? " (updating)" : "");
+
+	TArray<float> ColumnWidths;
+	DrawHeader(NumColumns, ColumnWidths);
+	DrawRows(NumColumns, NumRows, Height, ColumnWidths);
+
+	ImGui::PopID();
+}
+
+void FImGuiVirtualTable::UpdateQuery()
+{
+	if (PendingQuery.IsValid() && PendingQuery.IsReady())
+	{
+		DisplayedRows = PendingQuery.Get();
+		PendingQuery = TFuture<TArray<int32>>();
+	}
+
+	if (Provider->GetDataVersion() != QueriedDataVersion)
+	{
+		bQueryDirty = true;
+	}
+
+	if (bQueryDirty && !PendingQuery.IsValid())
+	{
+		StartQuery();
+	}
+}
+
+void FImGuiVirtualTable::StartQuery()
+{
+	const uint64 DataVersion = Provider->GetDataVersion();
+	const int32 NumRows = Provider->GetNumRows();
+	const FString Filter = UTF8_TO_TCHAR(FilterBuffer);
+
+	// Provider order doesn't need to read any cells, so there is no point in waiting for a worker.
+	if (Filter.IsEmpty() && SortColumn == INDEX_NONE)
+	{
+		bQueryDirty = false;
+		QueriedDataVersion = DataVersion;
+		DisplayedRows.SetNumUninitialized(NumRows);
+		for (int32 Row = 0; Row < NumRows; Row++)
+		{
+			DisplayedRows[Row] = Row;
+		}
+		return;
+	}
+
+	// Query stays dirty until all the columns it needs are copied, previous result is displayed in the meantime.
+	if (!UpdateSnapshots(DataVersion, NumRows, !Filter.IsEmpty()))
+	{
+		return;
+	}
+	bQueryDirty = false;
+	QueriedDataVersion = DataVersion;
+
+	const TSharedRef<FQueryInput, ESPMode::ThreadSafe> Input = MakeShared<FQueryInput, ESPMode::ThreadSafe>();
+	Input->NumRows = NumRows;
+	Input->Filter = Filter;
+	Input->bSortAscending = bSortAscending;
+	for (int32 Column = 0; Column < ColumnSnapshots.Num(); Column++)
+	{
+		if (!Filter.IsEmpty() && Provider->GetColumnType(Column) == EImGuiTableColumnType::Text)
+		{
+			Input->FilterColumns.Add(ColumnSnapshots[Column].ToSharedRef());
+		}
+	}
+	if (SortColumn != INDEX_NONE)
+	{
+		Input->SortKeys = ColumnSnapshots[SortColumn];
+	}
+	PendingQuery = Async<TArray<int32>>(EAsyncExecution::ThreadPool, [Input]()
+	{
+		return QueryRows(*Input);
+	});
+}
+
+bool FImGuiVirtualTable::UpdateSnapshots(uint64 DataVersion, int32 NumRows, bool bFilter)
+{
+	const int32 NumColumns = Provider->GetNumColumns();
+	if (DataVersion != SnapshotDataVersion || NumRows != SnapshotNumRows || ColumnSnapshots.Num() != NumColumns)
+	{
+		// Queries which are still running keep their own references to the old snapshots.
+		ColumnSnapshots.Reset();
+		ColumnSnapshots.SetNum(NumColumns);
+		SnapshotDataVersion = DataVersion;
+		SnapshotNumRows = NumRows;
+	}
+
+	int32 CellBudget = MaxSnapshotCellsPerFrame;
+	bool bComplete = true;
+	for (int32 Column = 0; Column < NumColumns; Column++)
+	{
+		if (Column == SortColumn || (bFilter && Provider->GetColumnType(Column) == EImGuiTableColumnType::Text))
+		{
+			bComplete &= CopyColumnCells(Column, CellBudget);
+		}
+	}
+	return bComplete;
+}
+
+bool FImGuiVirtualTable::CopyColumnCells(int32 Column, int32& InOutCellBudget)
+{
+	TSharedPtr<FImGuiTableColumnSnapshot, ESPMode::ThreadSafe>& Snapshot = ColumnSnapshots[Column];
+	const bool bNumber = Provider->GetColumnType(Column) == EImGuiTableColumnType::Number;
+	if (!Snapshot.IsValid())
+	{
+		Snapshot = MakeShared<FImGuiTableColumnSnapshot, ESPMode::ThreadSafe>();
+		if (bNumber)
+		{
+			Snapshot->Numbers.SetNumUninitialized(SnapshotNumRows);
+		}
+		else
+		{
+			Snapshot->Texts.SetNum(SnapshotNumRows);
+		}
+	}
+
+	const int32 EndRow = FMath::Min(SnapshotNumRows, Snapshot->NumCopiedRows + FMath::Max(InOutCellBudget, 0));
+	for (int32 Row = Snapshot->NumCopiedRows; Row < EndRow; Row++)
+	{
+		if (bNumber)
+		{
+			Snapshot->Numbers[Row] = Provider->GetNumber(Column, Row);
+		}
+		else
+		{
+			Snapshot->Texts[Row] = Provider->GetText(Column, Row);
+		}
+	}
+	InOutCellBudget -= EndRow - Snapshot->NumCopiedRows;
+	Snapshot->NumCopiedRows = EndRow;
+	return Snapshot->NumCopiedRows == SnapshotNumRows;
+}
+
+void FImGuiVirtualTable::DrawHeader(int32 NumColumns, TArray<float>& OutColumnWidths)
+{
+	ImGui::Columns(NumColumns, "Header");
+	for (int32 Column = 0; Column < NumColumns; Column++)
+	{
+		FString Label = Provider->GetColumnName(Column);
+		if (Column == SortColumn)
+		{
+			Label += bSortAscending ? TEXT(" (asc)") : TEXT(" (desc)");
+		}
+
+		// Clicking on the sorted column flips the order, and the third click restores the order of the provider.
+		ImGui::PushID(Column);
+		if (ImGui::Selectable(TCHAR_TO_UTF8(*Label), Column == SortColumn))
+		{
+			if (Column != SortColumn)
+			{
+				SetSortColumn(Column, true);
+			}
+			else if (bSortAscending)
+			{
+				SetSortColumn(Column, false);
+			}
+			else
+			{
+				SetSortColumn(INDEX_NONE);
+			}
+		}
+		ImGui::PopID();
+
+		OutColumnWidths.Add(ImGui::GetColumnWidth(Column));
+		ImGui::NextColumn();
+	}
+	ImGui::Columns(1);
+	ImGui::Separator();
+}
+
+void FImGuiVirtualTable::DrawRows(int32 NumColumns, int32 NumRows, float Height, const TArray<float>& ColumnWidths)
+{
+	// Rows are in a child window, so the header stays in place while they are scrolled. Rows columns follow the widths
+	// of the header columns, which are the ones user can resize.
+	ImGui::BeginChild("Rows", ImVec2(0.0f, Height));
+	ImGui::Columns(NumColumns, "Rows", false);
+	for (int32 Column = 0; Column < NumColumns - 1; Column++)
+	{
+		ImGui::SetColumnWidth(Column, ColumnWidths[Column]);
+	}
+
+	ImGuiListClipper Clipper(DisplayedRows.Num());
+	while (Clipper.Step())
+	{
+		for (int32 Index = Clipper.DisplayStart; Index < Clipper.DisplayEnd; Index++)
+		{
+			// Result of the last query can still refer to rows removed since then.
+			const int32 Row = DisplayedRows[Index];
+			for (int32 Column = 0; Column < NumColumns; Column++)
+			{
+				ImGui::TextUnformatted(Row < NumRows ? TCHAR_TO_UTF8(*Provider->FormatCell(Column, Row)) : "");
+				ImGui::NextColumn();
+			}
+		}
+	}
+
+	ImGui::Columns(1);
+	ImGui::EndChild();
+}
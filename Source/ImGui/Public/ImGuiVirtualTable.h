@@ -0,0 +1,130 @@
+// Distributed under the MIT License (MIT) (see accompanying LICENSE file)
+
+#pragma once
+
+#include <CoreMinimal.h>
+#include <Async/Future.h>
+
+#include <imgui.h>
+
+
+/** Type of values stored in a table column. Decides how rows are compared when sorting by that column. */
+enum class EImGuiTableColumnType : uint8
+{
+	Number,
+	Text
+};
+
+/**
+ * Columnar source of rows for FImGuiVirtualTable. Table pulls individual cells when it needs them: formatted cells only
+ * for rows which are visible, and raw values of the sorted and filtered columns once per data version.
+ *
+ * All methods are only called on the game thread. Sorting and filtering run on a worker thread, but they work on values
+ * copied by the table, so providers can read game objects directly and change them between frames.
+ */
+class IMGUI_API IImGuiTableDataProvider
+{
+public:
+
+	virtual ~IImGuiTableDataProvider() = default;
+
+	/** Get the number of rows. It must not change without changing data version. */
+	virtual int32 GetNumRows() const = 0;
+
+	/** Get the version of the data. Table copies cell values and sorts and filters rows again after it changes. */
+	virtual uint64 GetDataVersion() const = 0;
+
+	/** Get the number of columns. It must be constant during the lifetime of the provider. */
+	virtual int32 GetNumColumns() const = 0;
+
+	/** Get the name displayed in the header of the column. */
+	virtual FString GetColumnName(int32 Column) const = 0;
+
+	/** Get the type of values stored in the column. */
+	virtual EImGuiTableColumnType GetColumnType(int32 Column) const = 0;
+
+	/** Get the value of a number cell for sorting. */
+	virtual double GetNumber(int32 Column, int32 Row) const { return 0.0; }
+
+	/** Get the value of a text cell for sorting and filtering. */
+	virtual FString GetText(int32 Column, int32 Row) const { return FString(); }
+
+	/**
+	 * Format the cell for display. Called on the game thread only for visible rows.
+	 * Default implementation prints the number or text value of the cell.
+	 */
+	virtual FString FormatCell(int32 Column, int32 Row) const;
+};
+
+struct FImGuiTableColumnSnapshot;
+
+/**
+ * Table which can display hundreds of thousands of rows, because it emits widgets only for the rows which are visible.
+ * Rows are clipped with ImGuiListClipper and columns are laid out with ImGui columns. Header stays at the top while rows
+ * are scrolled and clicking on a column name sorts rows by that column.
+ *
+ * Sorting and filtering don't move any data, they produce an array of row indices on a worker thread. Only the cells of
+ * the sorted and filtered columns are copied on the game thread, once per data version and in bounded chunks per frame,
+ * so typing into the filter or changing the sort order doesn't copy anything. Until the result is ready, the table keeps
+ * displaying the previous one, so the game thread never waits for it.
+ */
+class IMGUI_API FImGuiVirtualTable
+{
+public:
+
+	/**
+	 * Creates a table for given data.
+	 * @param InId - ImGui id of the table, must be unique within the window
+	 * @param InProvider - Source of the rows
+	 */
+	FImGuiVirtualTable(const FString& InId, const TSharedRef<IImGuiTableDataProvider, ESPMode::ThreadSafe>& InProvider);
+
+	/**
+	 * Draws the table in the current ImGui window. Should be called every frame when the table is visible.
+	 * @param Height - Height of the scrolled rows area, 0 to use the remaining height of the window
+	 */
+	void Draw(float Height = 0.0f);
+
+	/** Get the number of rows passing the filter, as of the last finished query. */
+	int32 GetNumDisplayedRows() const { return DisplayedRows.Num(); }
+
+	/** Get the provider row displayed at the given position, as of the last finished query. */
+	int32 GetDisplayedRow(int32 DisplayIndex) const { return DisplayedRows[DisplayIndex]; }
+
+	/** Sort rows by given column, INDEX_NONE to keep the order of the provider. */
+	void SetSortColumn(int32 Column, bool bAscending = true);
+
+	/** Only display rows with a text column containing given string (case insensitive). Empty string disables filter. */
+	void SetFilter(const FString& Filter);
+
+private:
+
+	void StartQuery();
+	bool UpdateSnapshots(uint64 DataVersion, int32 NumRows, bool bFilter);
+	bool CopyColumnCells(int32 Column, int32& InOutCellBudget);
+	void UpdateQuery();
+	void DrawHeader(int32 NumColumns, TArray<float>& OutColumnWidths);
+	void DrawRows(int32 NumColumns, int32 NumRows, float Height, const TArray<float>& ColumnWidths);
+
+	FString Id;
+	TSharedRef<IImGuiTableDataProvider, ESPMode::ThreadSafe> Provider;
+
+	// Rows in display order, result of the last finished query.
+	TArray<int32> DisplayedRows;
+
+	// Query running on a worker thread. Only one query is running at a time, a change done in the meantime restarts it
+	// after it finishes.
+	TFuture<TArray<int32>> PendingQuery;
+	bool bQueryDirty = true;
+	uint64 QueriedDataVersion = 0;
+
+	// Snapshots of the columns needed by queries, indexed by column. They are copied again only when data version changes.
+	TArray<TSharedPtr<FImGuiTableColumnSnapshot, ESPMode::ThreadSafe>> ColumnSnapshots;
+	uint64 SnapshotDataVersion = 0;
+	int32 SnapshotNumRows = 0;
+
+	int32 SortColumn = INDEX_NONE;
+	bool bSortAscending = true;
+
+	char FilterBuffer[256];
+};
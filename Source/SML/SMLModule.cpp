@@ -9,6 +9,7 @@
 #include "MultiBoxBuilder.h"
 #include "AssetRegistryModule.h"
 #include "mod/toolkit/FGAssetGenerator.h"
+#include "util/Benchmarks.h"
 
 class FSMLCommands : public TCommands<FSMLCommands> {
 public:
@@ -21,9 +22,11 @@ public:
 	
 	virtual void RegisterCommands() override {
 		UI_COMMAND(DebugBlueprintsCommand, "Generate FG Assets", "Generate FactoryGame assets from dump file", EUserInterfaceActionType::Button, FInputChord());
+		UI_COMMAND(RunBenchmarksCommand, "Run SML Benchmarks", "Run SML benchmarks and write results into the log", EUserInterfaceActionType::Button, FInputChord());
 	}
 public:
 	TSharedPtr<FUICommandInfo> DebugBlueprintsCommand;
+	TSharedPtr<FUICommandInfo> RunBenchmarksCommand;
 };
 
 void SMLDebugButtonClicked() {
@@ -40,11 +43,16 @@ void FSMLModule::StartupModule() {
 		FSMLCommands::Get().DebugBlueprintsCommand,
 		FExecuteAction::CreateStatic(&SMLDebugButtonClicked),
 		FCanExecuteAction());
+	PluginCommands->MapAction(
+		FSMLCommands::Get().RunBenchmarksCommand,
+		FExecuteAction::CreateStatic(&SML::Benchmarks::runAllBenchmarks),
+		FCanExecuteAction());
 	
 	FLevelEditorModule& LevelEditorModule = FModuleManager::LoadModuleChecked<FLevelEditorModule>("LevelEditor");
 	TSharedPtr<FExtender> MenuExtender = MakeShareable(new FExtender());
 	MenuExtender->AddMenuExtension("FileProject", EExtensionHook::After, PluginCommands, FMenuExtensionDelegate::CreateLambda([](FMenuBuilder& Builder) {
 		Builder.AddMenuEntry(FSMLCommands::Get().DebugBlueprintsCommand);
+		Builder.AddMenuEntry(FSMLCommands::Get().RunBenchmarksCommand);
 	}));
 	LevelEditorModule.GetMenuExtensibilityManager()->AddExtender(MenuExtender);
 #endif
@@ -30,6 +30,9 @@
 #include "command/SMLChatCommands.h"
 #include "player/VersionCheck.h"
 #include "player/MainMenuMixin.h"
+#include "util/CacheManager.h"
+#include "util/StartupProfiler.h"
+#include "util/ModConfigRegistry.h"
 
 bool checkGameVersion(const long targetVersion) {
 	const FString& buildVersion = FString(FApp::GetBuildVersion());
@@ -61,6 +64,9 @@ void parseConfig(const TSharedRef<FJsonObject>& json, SML::FSMLConfiguration& co
 	config.developmentMode = json->GetBoolField(TEXT("developmentMode"));
 	config.debugLogOutput = json->GetBoolField(TEXT("debug"));
 	config.consoleWindow = json->GetBoolField(TEXT("consoleWindow"));
+	config.maxCacheSizeMb = static_cast<int64>(json->GetNumberField(TEXT("maxCacheSizeMb")));
+	json->TryGetStringArrayField(TEXT("logCategoryLevels"), config.logCategoryLevels);
+	config.binaryLogOutput = json->GetBoolField(TEXT("binaryLogOutput"));
 }
 
 TSharedRef<FJsonObject> createConfigDefaults() {
@@ -70,6 +76,9 @@ TSharedRef<FJsonObject> createConfigDefaults() {
 	ref->SetBoolField(TEXT("developmentMode"), false);
 	ref->SetBoolField(TEXT("debug"), false);
 	ref->SetBoolField(TEXT("consoleWindow"), false);
+	ref->SetNumberField(TEXT("maxCacheSizeMb"), 2048);
+	ref->SetArrayField(TEXT("logCategoryLevels"), TArray<TSharedPtr<FJsonValue>>());
+	ref->SetBoolField(TEXT("binaryLogOutput"), false);
 	return ref;
 }
 
@@ -89,6 +98,9 @@ namespace SML {
 	
 	//name of the file which will be used for logging purposes
 	static const TCHAR* logFileName = TEXT("SatisfactoryModLoader.log");
+
+	//name of the file used for logging when binary log output is enabled
+	static const TCHAR* binaryLogFileName = TEXT("SatisfactoryModLoader.smllog");
 	
 	//CL of Satisfactory we want to target
 	//SML will be unable to load in production mode if it doesn't match actual game version
@@ -105,6 +117,9 @@ namespace SML {
 	//Pointer to the SML log file
 	static std::wofstream* logOutputStream;
 
+	//Guards log file and console output against concurrent writes
+	static std::mutex logOutputMutex;
+
 	//Holds pointers to the bootstrapper functions used for loading modules
 	static BootstrapAccessors* bootstrapAccessors;
 
@@ -120,9 +135,11 @@ namespace SML {
 	//called by a bootstrapper off the engine thread during process initialization
 	//you should not access engine at that point since for now no engine code was executed
 	void bootstrapSML(BootstrapAccessors& accessors) {
+		SML_STARTUP_TIMER(TEXT("bootstrapSML"));
 		bootstrapAccessors = new BootstrapAccessors(accessors);
 		logOutputStream = new std::wofstream();
 		logOutputStream->open(*(FString(accessors.gameRootDirectory) / logFileName), std::ios_base::out | std::ios_base::trunc);
+		SML::Logging::startAsyncLogWriter();
 
 		SML::Logging::info(TEXT("Log System Initialized!"));
 		SML::Logging::info(TEXT("Constructing SatisfactoryModLoader v"), *modLoaderVersion->string());
@@ -147,6 +164,14 @@ namespace SML {
 		const TSharedRef<FJsonObject>& configJson = readModConfig(TEXT("SML"), createConfigDefaults());
 		activeConfiguration = new FSMLConfiguration;
 		parseConfig(configJson, *activeConfiguration);
+		SML::Logging::applyLogCategoryLevels(*activeConfiguration);
+		if (activeConfiguration->binaryLogOutput) {
+			const FString binaryLogPath = *rootGamePath / binaryLogFileName;
+			SML::Logging::info(TEXT("Switching to binary log output: "), *binaryLogPath);
+			if (!SML::BinaryLog::openBinaryLog(binaryLogPath)) {
+				SML::Logging::error(TEXT("Failed to open binary log file, falling back to text log"));
+			}
+		}
 
 		initConsole();
 
@@ -184,9 +209,14 @@ namespace SML {
 	//called after primary engine initialization, it is safe
 	//to load modules, mount paks and access most of the engine systems here
 	//however note that level could still be not loaded at that moment
+	//startup report is written later, once mod actors of the first map are initialized
 	void postInitializeSML() {
+		SML_STARTUP_TIMER(TEXT("postInitializeSML"));
+		SML::Config::startConfigRegistry();
 		SML::Logging::info(TEXT("Loading Mods..."));
 		modHandlerPtr->loadMods(*bootstrapAccessors);
+		initializeModListManifest();
+		SML::Cache::scheduleCacheEviction();
 		SML::Logging::info(TEXT("Post Initialization finished!"));
 		flushDebugSymbols();
 	}
@@ -215,6 +245,10 @@ namespace SML {
 		return *logOutputStream;
 	}
 
+	SML_API std::mutex& getLogMutex() {
+		return logOutputMutex;
+	}
+
 	SML_API const SML::Versioning::FVersion& getModLoaderVersion() {
 		return *modLoaderVersion;
 	}
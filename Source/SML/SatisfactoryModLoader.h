@@ -1,4 +1,5 @@
 #pragma once
+#include <mutex>
 #include "mod/version.h"
 #include "mod/ModHandler.h"
 
@@ -37,6 +38,26 @@ namespace SML {
 		* for allowing you to better debug the runtime
 		*/
 		bool consoleWindow;
+
+		/**
+		 * Maximum size of the .cache directory with extracted mod files, in megabytes
+		 * Least recently used entries are evicted in background after mods are loaded
+		 * Set to 0 to disable cache eviction
+		 */
+		int64 maxCacheSizeMb;
+
+		/**
+		 * Per-category minimum log levels, in "<Category>=<level>" format
+		 * For example, "LogSML=warning" hides SML's own info messages
+		 */
+		TArray<FString> logCategoryLevels;
+
+		/**
+		 * Writes log into compact structured binary file SatisfactoryModLoader.smllog
+		 * instead of the text log file. Messages are still forwarded to the engine log and console,
+		 * fatal ones are also written into the text log file. Use SMLLogDecoder tool to read the resulting file
+		 */
+		bool binaryLogOutput;
 	};
 };
 
@@ -61,6 +82,12 @@ namespace SML {
 	 */
 	SML_API extern std::wofstream& getLogFile();
 
+	/**
+	 * Returns mutex guarding writes to the SML log file and console output
+	 * Logging can happen from worker threads, for example during mod archive extraction
+	 */
+	SML_API extern std::mutex& getLogMutex();
+
 	/**
 	 * Retrieves mod handler global object
 	 * It manages mod loading and can be used to retrieve information
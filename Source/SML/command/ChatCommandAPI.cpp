@@ -21,16 +21,122 @@ public: void SendChatMessage(const FChatMessageStruct&) {}
 
 namespace SML {
 	namespace ChatCommand {
-		//holds the mapping of the command name/alias to the command registrar entry
-		static TMap<FString, FCommandRegistrarEntry> registeredCommands;
+		/**
+		 * Node of the command name trie, children of a node are linked through nextSibling
+		 * and sorted by character, so walking the trie yields names in alphabetical order
+		 */
+		struct FCommandTrieNode {
+			TCHAR character;
+			int32 firstChild;
+			int32 nextSibling;
+			//index of the command in registeredCommandsList, or INDEX_NONE if no name ends here
+			int32 commandIndex;
+			//index of the name ending here in registeredCommandNames
+			int32 nameIndex;
+		};
+
+		//trie of all command names and aliases, both short and fully qualified, lower case. node 0 is the root
+		static TArray<FCommandTrieNode> commandTrie = { FCommandTrieNode{ TEXT('\0'), INDEX_NONE, INDEX_NONE, INDEX_NONE, INDEX_NONE } };
+		//registered names in their original case, referenced by the trie nodes
+		static TArray<FString> registeredCommandNames;
 		//holds the list of all registered commands
 		static TArray<FCommandRegistrarEntry> registeredCommandsList;
 
+		//returns child of the given node with the given lower case character, inserting it if needed
+		int32 findOrAddTrieChild(int32 nodeIndex, TCHAR character) {
+			int32 previousIndex = INDEX_NONE;
+			int32 childIndex = commandTrie[nodeIndex].firstChild;
+			while (childIndex != INDEX_NONE && commandTrie[childIndex].character < character) {
+				previousIndex = childIndex;
+				childIndex = commandTrie[childIndex].nextSibling;
+			}
+			if (childIndex != INDEX_NONE && commandTrie[childIndex].character == character) {
+				return childIndex;
+			}
+			const int32 newIndex = commandTrie.Add(FCommandTrieNode{ character, INDEX_NONE, childIndex, INDEX_NONE, INDEX_NONE });
+			if (previousIndex == INDEX_NONE) {
+				commandTrie[nodeIndex].firstChild = newIndex;
+			} else {
+				commandTrie[previousIndex].nextSibling = newIndex;
+			}
+			return newIndex;
+		}
+
+		//returns node reached by the given name, or INDEX_NONE
+		int32 findTrieNode(const TCHAR* name, int32 nameLength) {
+			int32 nodeIndex = 0;
+			for (int32 i = 0; i < nameLength && nodeIndex != INDEX_NONE; i++) {
+				const TCHAR character = FChar::ToLower(name[i]);
+				nodeIndex = commandTrie[nodeIndex].firstChild;
+				while (nodeIndex != INDEX_NONE && commandTrie[nodeIndex].character < character) {
+					nodeIndex = commandTrie[nodeIndex].nextSibling;
+				}
+				if (nodeIndex != INDEX_NONE && commandTrie[nodeIndex].character != character) {
+					nodeIndex = INDEX_NONE;
+				}
+			}
+			return nodeIndex;
+		}
+
+		void addCommandName(const FString& name, int32 commandIndex) {
+			int32 nodeIndex = 0;
+			for (const TCHAR character : name) {
+				nodeIndex = findOrAddTrieChild(nodeIndex, FChar::ToLower(character));
+			}
+			FCommandTrieNode& node = commandTrie[nodeIndex];
+			if (node.nameIndex == INDEX_NONE) {
+				node.nameIndex = registeredCommandNames.Add(name);
+			}
+			//later registrations override earlier ones, same as before
+			node.commandIndex = commandIndex;
+		}
+
+		const FCommandRegistrarEntry* findCommand(const TCHAR* name, int32 nameLength) {
+			const int32 nodeIndex = findTrieNode(name, nameLength);
+			if (nodeIndex == INDEX_NONE || commandTrie[nodeIndex].commandIndex == INDEX_NONE) {
+				return nullptr;
+			}
+			return &registeredCommandsList[commandTrie[nodeIndex].commandIndex];
+		}
+
 		TOptional<FCommandRegistrarEntry> getCommandByName(const FString& name) {
-			if (!registeredCommands.Contains(name)) {
+			const FCommandRegistrarEntry* commandEntry = findCommand(*name, name.Len());
+			if (commandEntry == nullptr) {
 				return TOptional<FCommandRegistrarEntry>();
 			}
-			return TOptional<FCommandRegistrarEntry>(registeredCommands[name]);
+			return TOptional<FCommandRegistrarEntry>(*commandEntry);
+		}
+
+		TArray<FString> getCommandCompletions(const FString& prefix, int32 maxResults) {
+			TArray<FString> completions;
+			const int32 prefixNode = findTrieNode(*prefix, prefix.Len());
+			if (prefixNode == INDEX_NONE) {
+				return completions;
+			}
+			if (commandTrie[prefixNode].commandIndex != INDEX_NONE) {
+				completions.Add(registeredCommandNames[commandTrie[prefixNode].nameIndex]);
+			}
+			//pre-order walk over the subtree, visiting children before siblings
+			TArray<int32, TInlineAllocator<32>> pendingNodes;
+			if (commandTrie[prefixNode].firstChild != INDEX_NONE) {
+				pendingNodes.Add(commandTrie[prefixNode].firstChild);
+			}
+			while (pendingNodes.Num() > 0 && completions.Num() < maxResults) {
+				const FCommandTrieNode& node = commandTrie[pendingNodes.Pop(false)];
+				if (node.commandIndex != INDEX_NONE) {
+					completions.Add(registeredCommandNames[node.nameIndex]);
+				}
+				if (node.nextSibling != INDEX_NONE) {
+					pendingNodes.Add(node.nextSibling);
+				}
+				if (node.firstChild != INDEX_NONE) {
+					pendingNodes.Add(node.firstChild);
+				}
+			}
+			if (completions.Num() > maxResults) {
+				completions.SetNum(maxResults);
+			}
+			return completions;
 		}
 		
 		//returns the list of all registered commands
@@ -39,18 +145,75 @@ namespace SML {
 		}
 
 		void registerCommand(const FCommandRegistrarEntry& commandEntry) {
-			TArray<FString> allCommandNames = TArray<FString>(commandEntry.aliases);
-			allCommandNames.AddUnique(commandEntry.commandName);
+			const int32 commandIndex = registeredCommandsList.Add(commandEntry);
 			//register all command aliases
-			for (const FString& commandAlias : allCommandNames) {
-				const FString fqCommandName = FString::Printf(TEXT("%s:%s"), *commandEntry.modid, *commandAlias);
+			addCommandName(commandEntry.commandName, commandIndex);
+			addCommandName(FString::Printf(TEXT("%s:%s"), *commandEntry.modid, *commandEntry.commandName), commandIndex);
+			for (const FString& commandAlias : commandEntry.aliases) {
 				//register short command name
-				registeredCommands.Add(commandAlias, commandEntry);
+				addCommandName(commandAlias, commandIndex);
 				//register fully qualified command name
-				registeredCommands.Add(fqCommandName, commandEntry);
+				addCommandName(FString::Printf(TEXT("%s:%s"), *commandEntry.modid, *commandAlias), commandIndex);
 			}
-			//register command entry
-			registeredCommandsList.Add(commandEntry);
+		}
+
+		bool FCommandArgument::equals(const TCHAR* other) const {
+			return FCString::Strnicmp(data, other, length) == 0 && other[length] == TEXT('\0');
+		}
+
+		FString FCommandArgument::toString() const {
+			return FString(length, data);
+		}
+
+		FCommandArguments::FCommandArguments(const FString& commandLine) {
+			const int32 lineLength = commandLine.Len();
+			//arguments are unescaped in place, which only ever shrinks them, so one copy of the line is enough
+			buffer.SetNumUninitialized(lineLength + 1);
+			FMemory::Memcpy(buffer.GetData(), *commandLine, lineLength * sizeof(TCHAR));
+			buffer[lineLength] = TEXT('\0');
+			TCHAR* const data = buffer.GetData();
+			int32 readOffset = 0;
+			while (true) {
+				//skip argument separators
+				while (readOffset < lineLength && data[readOffset] == TEXT(' ')) {
+					readOffset++;
+				}
+				if (readOffset >= lineLength) {
+					break;
+				}
+				const int32 argumentStart = readOffset;
+				int32 writeOffset = readOffset;
+				bool isQuoted = false;
+				while (readOffset < lineLength) {
+					const TCHAR character = data[readOffset++];
+					if (character == TEXT('\\') && readOffset < lineLength) {
+						data[writeOffset++] = data[readOffset++];
+					} else if (character == TEXT('"')) {
+						isQuoted = !isQuoted;
+					} else if (character == TEXT(' ') && !isQuoted) {
+						break;
+					} else {
+						data[writeOffset++] = character;
+					}
+				}
+				arguments.Add(FCommandArgument{ data + argumentStart, writeOffset - argumentStart });
+			}
+			argumentStrings.SetNum(arguments.Num());
+		}
+
+		const FString& FCommandArguments::operator[](int32 index) const {
+			FString& argumentString = argumentStrings[index];
+			if (argumentString.IsEmpty() && arguments[index].length > 0) {
+				argumentString = arguments[index].toString();
+			}
+			return argumentString;
+		}
+
+		const TArray<FString>& FCommandArguments::toStringArray() const {
+			for (int32 i = 0; i < arguments.Num(); i++) {
+				operator[](i);
+			}
+			return argumentStrings;
 		}
 
 		void printCommandNotFound(AFGPlayerController* player) {
@@ -58,75 +221,146 @@ namespace SML {
 			component->SendChatMessage(TEXT("Unknown command. Type /help for a list of commands."), FLinearColor::Red);
 		}
 
-		FString parseArgument(const FString& line, size_t& off);
-
 		EExecutionStatus runChatCommand(const FString& commandLine, AFGPlayerController* player) {
-			if (commandLine.IsEmpty()) {
+			const FCommandArguments arguments(commandLine);
+			if (arguments.Num() == 0) {
 				printCommandNotFound(player);
 				return EExecutionStatus::BAD_ARGUMENTS;
 			}
-			TArray<FString> resultArgArray;
-			size_t offset = 0;
-			while (commandLine.Len() > offset) {
-				FString resultArg = parseArgument(commandLine, offset);
-				resultArgArray.Add(std::move(resultArg));
-				offset++; //skip argument separator
-			}
-			const FString& commandName = resultArgArray[0];
-			if (!registeredCommands.Contains(commandName)) {
+			const FCommandArgument& commandName = arguments.view(0);
+			const FCommandRegistrarEntry* commandEntry = findCommand(commandName.data, commandName.length);
+			if (commandEntry == nullptr) {
 				printCommandNotFound(player);
 				return EExecutionStatus::BAD_ARGUMENTS;
 			}
-			const FCommandRegistrarEntry& commandEntry = registeredCommands[commandName];
-			const FCommandData commandData{ resultArgArray, player };
-			const EExecutionStatus resultStatus = (*commandEntry.commandHandler)(commandData);
+			const FCommandData commandData{ arguments, player };
+			const EExecutionStatus resultStatus = (*commandEntry->commandHandler)(commandData);
 			return resultStatus;
 		}
 
-		FString parseArgument(const FString& line, size_t& off) {
-			if (off >= line.Len()) return TEXT("");
-			wchar_t escapeChar = TEXT('\\');
-			wchar_t firstChar = line[off++];
-			bool previousCharIsEscape = firstChar == escapeChar;
-			bool isQuoted = firstChar == TEXT('"');
-			wchar_t breakCharacter = isQuoted ? TEXT('"') : TEXT(' ');
-			FString result;
-			//if first char is not a quote, append it too!
-			if (!isQuoted && !previousCharIsEscape) 
-				result.AppendChar(firstChar);
-			while (line.Len() > off) {
-				const wchar_t character = line[off];
-				if (!previousCharIsEscape) {
-					//break on the control character
-					if (character == breakCharacter) break;
-					//set last character as escape
-					if (character == escapeChar) {
-						previousCharIsEscape = true;
-						//continue here to skip resetting prevIsEscape
-						//and adding character to the result
-						continue; 
+		/**
+		 * Filters of the player selector, parsed from @x[key=value,...]
+		 * Distances are in meters, center defaults to the caller's location
+		 */
+		struct FPlayerSelectorFilter {
+			FVector center = FVector::ZeroVector;
+			bool hasCenter = false;
+			float minRadius = -1.0f;
+			float maxRadius = -1.0f;
+			FVector areaSize = FVector::ZeroVector;
+			bool hasArea = false;
+			int32 limit = MAX_int32;
+
+			bool matches(const AFGPlayerController* controller) const {
+				if (maxRadius < 0.0f && minRadius < 0.0f && !hasArea) {
+					return true;
+				}
+				const APawn* pawn = controller->GetPawn();
+				if (pawn == nullptr || !hasCenter) {
+					return false;
+				}
+				const FVector location = pawn->GetActorLocation();
+				const float distanceSquared = FVector::DistSquared(location, center);
+				if (maxRadius >= 0.0f && distanceSquared > FMath::Square(maxRadius)) return false;
+				if (minRadius >= 0.0f && distanceSquared < FMath::Square(minRadius)) return false;
+				//area is a box spanning from the center by areaSize on each axis, like dx/dy/dz in other games
+				if (hasArea) {
+					const FVector areaEnd = center + areaSize;
+					if (location.X < FMath::Min(center.X, areaEnd.X) || location.X > FMath::Max(center.X, areaEnd.X) ||
+						location.Y < FMath::Min(center.Y, areaEnd.Y) || location.Y > FMath::Max(center.Y, areaEnd.Y) ||
+						location.Z < FMath::Min(center.Z, areaEnd.Z) || location.Z > FMath::Max(center.Z, areaEnd.Z)) {
+						return false;
 					}
 				}
-				result.AppendChar(character);
-				previousCharIsEscape = false;
-				off++;
+				return true;
 			}
-			return result;
+		};
+
+		//parses key=value pairs of the selector in place. returns false on malformed input
+		bool parseSelectorFilter(const TCHAR* cursor, AFGPlayerController* caller, FPlayerSelectorFilter& filter) {
+			const APawn* callerPawn = caller != nullptr ? caller->GetPawn() : nullptr;
+			if (callerPawn != nullptr) {
+				filter.center = callerPawn->GetActorLocation();
+				filter.hasCenter = true;
+			}
+			if (*cursor == TEXT('\0')) {
+				return true;
+			}
+			if (*cursor++ != TEXT('[')) {
+				return false;
+			}
+			while (*cursor != TEXT(']')) {
+				const TCHAR* keyStart = cursor;
+				while (*cursor != TEXT('=') && *cursor != TEXT('\0')) cursor++;
+				if (*cursor == TEXT('\0')) return false;
+				const int32 keyLength = cursor++ - keyStart;
+				const TCHAR* valueStart = cursor;
+				while (FChar::IsDigit(*cursor) || *cursor == TEXT('.') || *cursor == TEXT('-')) cursor++;
+				if (cursor == valueStart) return false;
+				const float value = FCString::Atof(valueStart);
+				auto isKey = [keyStart, keyLength](const TCHAR* key) {
+					return FCString::Strlen(key) == keyLength && FCString::Strnicmp(keyStart, key, keyLength) == 0;
+				};
+				//selector distances are in meters, engine ones are in centimeters
+				const float distance = value * 100.0f;
+				if (isKey(TEXT("r"))) filter.maxRadius = distance;
+				else if (isKey(TEXT("rm"))) filter.minRadius = distance;
+				else if (isKey(TEXT("x"))) { filter.center.X = distance; filter.hasCenter = true; }
+				else if (isKey(TEXT("y"))) { filter.center.Y = distance; filter.hasCenter = true; }
+				else if (isKey(TEXT("z"))) { filter.center.Z = distance; filter.hasCenter = true; }
+				else if (isKey(TEXT("dx"))) { filter.areaSize.X = distance; filter.hasArea = true; }
+				else if (isKey(TEXT("dy"))) { filter.areaSize.Y = distance; filter.hasArea = true; }
+				else if (isKey(TEXT("dz"))) { filter.areaSize.Z = distance; filter.hasArea = true; }
+				else if (isKey(TEXT("c"))) filter.limit = FMath::Max(0, static_cast<int32>(value));
+				else return false;
+				if (*cursor == TEXT(',')) cursor++;
+				else if (*cursor != TEXT(']')) return false;
+			}
+			return *(cursor + 1) == TEXT('\0');
 		}
 
 		TArray<AFGPlayerController*> parsePlayerName(AFGPlayerController* caller, const FString& name) {
 			UWorld* world = caller != nullptr ? caller->GetWorld() : GWorld;
-			if (name == TEXT("@s")) {
-				//check if caller is null, then return empty vector
-				return singleElement(caller);
-			} else if (name == TEXT("@a")) {
-				//give priority to the caller's world, if caller is null, use global world instance
-				return getConnectedPlayers(world);
-			} else {
+			const TCHAR* selector = *name;
+			if (selector[0] != TEXT('@')) {
 				//try to fetch player by name
 				AFGPlayerController* controller = GetPlayerByName(world, name);
 				return singleElement(controller);
 			}
+			const TCHAR selectorType = FChar::ToLower(selector[1]);
+			FPlayerSelectorFilter filter;
+			if (selectorType == TEXT('\0') || !parseSelectorFilter(selector + 2, caller, filter)) {
+				return TArray<AFGPlayerController*>();
+			}
+			TArray<AFGPlayerController*> result;
+			if (selectorType == TEXT('s')) {
+				//check if caller is null, then return empty vector
+				if (caller != nullptr && filter.matches(caller)) {
+					result.Add(caller);
+				}
+			} else if (selectorType == TEXT('a')) {
+				//give priority to the caller's world, if caller is null, use global world instance
+				for (FConstPlayerControllerIterator iterator = world->GetPlayerControllerIterator(); iterator && result.Num() < filter.limit; iterator++) {
+					AFGPlayerController* controller = static_cast<AFGPlayerController*>((*iterator).Get());
+					if (controller != nullptr && filter.matches(controller)) {
+						result.Add(controller);
+					}
+				}
+			} else if (selectorType == TEXT('r')) {
+				//reservoir sampling picks a uniformly random matching player in a single pass
+				AFGPlayerController* chosenController = nullptr;
+				int32 matchedPlayers = 0;
+				for (FConstPlayerControllerIterator iterator = world->GetPlayerControllerIterator(); iterator; iterator++) {
+					AFGPlayerController* controller = static_cast<AFGPlayerController*>((*iterator).Get());
+					if (controller != nullptr && filter.matches(controller) && FMath::RandHelper(++matchedPlayers) == 0) {
+						chosenController = controller;
+					}
+				}
+				if (chosenController != nullptr && filter.limit > 0) {
+					result.Add(chosenController);
+				}
+			}
+			return result;
 		}
 	};
 };
\ No newline at end of file
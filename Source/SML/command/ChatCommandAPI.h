@@ -20,20 +20,67 @@ namespace SML {
 			BAD_ARGUMENTS
 		};
 
+		/**
+		 * Slice of the command line holding a single argument
+		 * Points into the buffer of the owning FCommandArguments, so it's only valid as long as it is
+		 */
+		struct SML_API FCommandArgument {
+			const TCHAR* data;
+			int32 length;
+
+			/** Compares argument with the given string, ignoring case */
+			bool equals(const TCHAR* other) const;
+
+			/** Copies argument into a new string */
+			FString toString() const;
+		};
+
+		/**
+		 * Arguments of the command line, tokenized without copying each argument into a separate string
+		 * Arguments are separated by spaces, characters enclosed in "" are considered a single argument,
+		 * and \ escapes the following character, including quotes and spaces
+		 * FString views of the arguments are only created on demand
+		 */
+		class SML_API FCommandArguments {
+		private:
+			TArray<TCHAR> buffer;
+			TArray<FCommandArgument> arguments;
+			mutable TArray<FString> argumentStrings;
+		public:
+			explicit FCommandArguments(const FString& commandLine);
+			FCommandArguments(const FCommandArguments&) = delete;
+
+			FORCEINLINE int32 Num() const { return arguments.Num(); }
+
+			/** Returns argument slice at the given index */
+			FORCEINLINE const FCommandArgument& view(int32 index) const { return arguments[index]; }
+
+			/** Returns argument at the given index as a string, creating it on first access */
+			const FString& operator[](int32 index) const;
+
+			/** Returns all arguments as strings, creating ones not accessed yet */
+			const TArray<FString>& toStringArray() const;
+
+			FORCEINLINE operator const TArray<FString>&() const { return toStringArray(); }
+			FORCEINLINE const FString* begin() const { return toStringArray().GetData(); }
+			FORCEINLINE const FString* end() const { return begin() + Num(); }
+		};
+
 		/**
 		* Holds information about a command and it's arguments.
 		*
 		* Arguments are the values following the command, seperated by a space.
-		* argc is the amount of args and argv is a string vector of the args.
 		* The first arg is always the command itself.
+		* argv used to be a TArray<FString> reference. Handlers using it like an array still compile unchanged,
+		* but mods built against older SML versions have to be rebuilt, because the layout has changed
 		*/
 		struct FCommandData {
 			/**
-			* The arguments in a string array.
+			* The arguments of the command line.
 			*
 			* Always has the command and the following arguments seperated by a space.
 			*/
-			const TArray<FString>& argv;
+			const FCommandArguments& argv;
 
 			/**
 			* The player that executed this command.
@@ -81,6 +128,18 @@ namespace SML {
 
 		TOptional<FCommandRegistrarEntry> getCommandByName(const FString& name);
 
+		/**
+		 * Returns command registered with the given name or alias, or nullptr if there is none
+		 * Both short and modid:name forms are accepted, case is ignored
+		 */
+		SML_API const FCommandRegistrarEntry* findCommand(const TCHAR* name, int32 nameLength);
+
+		/**
+		 * Returns registered command names and aliases starting with the given prefix, sorted alphabetically
+		 * At most maxResults names are returned
+		 */
+		SML_API TArray<FString> getCommandCompletions(const FString& prefix, int32 maxResults = 16);
+
 		const TArray<FCommandRegistrarEntry>& getRegisteredCommands();
 
 		/**
@@ -90,15 +149,18 @@ namespace SML {
 
 		/**
 		* Parses command line and executes given command
-		* Characters enclosed in "" are considered a single argument
+		* Characters enclosed in "" are considered a single argument, see FCommandArguments
 		* If command is not found, returns bad_arguments
 		*/
 		SML_API EExecutionStatus runChatCommand(const FString& commandLine, AFGPlayerController* player);
 
 		/**
-		 * Parses given player name, returning all players matching
-		 * for now it just returns player with a matching username, or the player who called the command in case of @self
-		 * it will be improved in future to support different use-cases
+		 * Parses given player name or selector, returning all players matching
+		 * Selectors are @s (caller), @a (all players) and @r (random player), optionally followed
+		 * by filters in brackets, e.g. @a[r=50] or @r[x=100,y=200,z=0,dx=50,dy=50,dz=20]
+		 * r/rm - max/min distance from center, x/y/z - center, dx/dy/dz - area box from center, c - max players
+		 * Distances are in meters, center defaults to the caller's location
+		 * Anything not starting with @ is looked up as a player name
 		 */
 		SML_API TArray<AFGPlayerController*> parsePlayerName(AFGPlayerController* caller, const FString& name);
 	}
@@ -1,6 +1,10 @@
 #include "BlueprintLibrary.h"
 
 #include "SML/util/Logging.h"
+#include "Misc/ScopeLock.h"
+
+//category used by blueprint mods logging through LogDebug
+SML_DEFINE_LOG_CATEGORY(LogSMLBlueprint);
 
 FString makeBetterPropName(FString name) {
 	int32 index;
@@ -11,69 +15,220 @@ FString makeBetterPropName(FString name) {
 	return name;
 }
 
-TSharedPtr<FJsonObject> USMLBlueprintLibrary::convertUStructToJsonObject(UStruct* Struct, void* ptrToStruct) {
-	auto obj = TSharedPtr<FJsonObject>(new FJsonObject());
+struct FPropertyPlan;
+typedef TSharedPtr<FJsonValue>(*FPropertyToJsonFunc)(const FPropertyPlan& plan, void* ptrToProp);
+typedef void(*FJsonToPropertyFunc)(const FPropertyPlan& plan, const TSharedPtr<FJsonValue>& json, void* ptrToProp);
+
+/**
+ * Precomputed conversion of a single property, with converters picked once by property class
+ * Array properties hold a plan of their inner property
+ */
+struct FPropertyPlan {
+	UProperty* property;
+	FPropertyToJsonFunc toJson;
+	FJsonToPropertyFunc fromJson;
+	TSharedPtr<FPropertyPlan> innerPlan;
+};
+
+/**
+ * Conversion plan of the whole struct: json key names, offsets and converters of all its fields
+ * Blueprint structs and classes are recompiled in place, so plan also records layout of the struct it was built for
+ */
+struct FStructPlan {
+	struct FFieldPlan {
+		FString key;
+		int32 offset;
+		FPropertyPlan plan;
+	};
+	TArray<FFieldPlan> fields;
+	//recompilation recreates properties and relinks the struct, so these change together with the layout
+	UField* children;
+	UProperty* propertyLink;
+	int32 propertiesSize;
+
+	bool matchesLayout(const UStruct* Struct) const {
+		return Struct->Children == children && Struct->PropertyLink == propertyLink &&
+			Struct->PropertiesSize == propertiesSize;
+	}
+};
+
+//cached struct plans. weak keys make sure plan is never reused for other struct allocated at the same address,
+//and plans of structs recompiled in place are rebuilt once their layout no longer matches
+static TMap<TWeakObjectPtr<UStruct>, TSharedPtr<const FStructPlan>> structPlans;
+static FCriticalSection structPlansLock;
+
+FPropertyPlan makePropertyPlan(UProperty* prop);
+
+TSharedRef<const FStructPlan> getStructPlan(UStruct* Struct) {
+	{
+		FScopeLock lock(&structPlansLock);
+		const TSharedPtr<const FStructPlan>* existingPlan = structPlans.Find(Struct);
+		if (existingPlan != nullptr && (*existingPlan)->matchesLayout(Struct)) {
+			return existingPlan->ToSharedRef();
+		}
+	}
+	TSharedRef<FStructPlan> plan = MakeShareable(new FStructPlan());
 	for (auto prop = TFieldIterator<UProperty>(Struct); prop; ++prop) {
-		obj->SetField(makeBetterPropName(prop->GetName()), convertUPropToJsonValue(*prop, prop->ContainerPtrToValuePtr<void>(ptrToStruct)));
+		plan->fields.Add(FStructPlan::FFieldPlan{ makeBetterPropName(prop->GetName()), prop->GetOffset_ForInternal(), makePropertyPlan(*prop) });
+	}
+	plan->children = Struct->Children;
+	plan->propertyLink = Struct->PropertyLink;
+	plan->propertiesSize = Struct->PropertiesSize;
+	FScopeLock lock(&structPlansLock);
+	structPlans.Add(Struct, plan);
+	return plan;
+}
+
+TSharedPtr<FJsonObject> structToJsonObject(const FStructPlan& plan, void* ptrToStruct) {
+	TSharedPtr<FJsonObject> obj = MakeShareable(new FJsonObject());
+	obj->Values.Reserve(plan.fields.Num());
+	for (const FStructPlan::FFieldPlan& field : plan.fields) {
+		obj->Values.Add(field.key, field.plan.toJson(field.plan, static_cast<uint8*>(ptrToStruct) + field.offset));
 	}
 	return obj;
 }
 
-void USMLBlueprintLibrary::convertJsonObjectToUStruct(TSharedPtr<FJsonObject> json, UStruct* Struct, void* ptrToStruct) {
-	auto obj = TSharedPtr<FJsonObject>(new FJsonObject());
-	for (auto prop = TFieldIterator<UProperty>(Struct); prop; ++prop) {
-		auto field = json->TryGetField(makeBetterPropName(prop->GetName()));
-		if (!field.IsValid()) continue;
-		convertJsonValueToUProperty(field, *prop, prop->ContainerPtrToValuePtr<void>(ptrToStruct));
+void jsonObjectToStruct(const FStructPlan& plan, const TSharedPtr<FJsonObject>& json, void* ptrToStruct) {
+	for (const FStructPlan::FFieldPlan& field : plan.fields) {
+		const TSharedPtr<FJsonValue>* value = json->Values.Find(field.key);
+		if (value == nullptr || !value->IsValid()) continue;
+		field.plan.fromJson(field.plan, *value, static_cast<uint8*>(ptrToStruct) + field.offset);
 	}
 }
 
-void USMLBlueprintLibrary::convertJsonValueToUProperty(TSharedPtr<FJsonValue> json, UProperty* prop, void* ptrToProp) {
-	if (auto strProp = Cast<UStrProperty>(prop)) {
-		strProp->SetPropertyValue(ptrToProp, json->AsString());
-	} else if (auto fProp = Cast<UFloatProperty>(prop)) {
-		fProp->SetPropertyValue(ptrToProp, json->AsNumber());
-	} else if (auto iProp = Cast<UIntProperty>(prop)) {
-		iProp->SetPropertyValue(ptrToProp, json->AsNumber());
-	} else if (auto bProp = Cast<UBoolProperty>(prop)) {
-		bProp->SetPropertyValue(ptrToProp, json->AsBool());
-	} else if (auto aProp = Cast<UArrayProperty>(prop)) {
-		FScriptArray arr;
-		TArray<TSharedPtr<FJsonValue>> jsonArr = json->AsArray();
-		arr.Add(jsonArr.Num(), aProp->Inner->ElementSize);
-		for (int i = 0; i < jsonArr.Num(); i++) {
-			convertJsonValueToUProperty(jsonArr[i], aProp->Inner, (void*)((size_t)arr.GetData() + i * aProp->Inner->ElementSize));
-		}
-		aProp->SetPropertyValue(ptrToProp, arr);
-	} else if (auto sProp = Cast<UStructProperty>(prop)) {
-		convertJsonObjectToUStruct(json->AsObject(), sProp->Struct, ptrToProp);
+TSharedPtr<FJsonValue> stringToJson(const FPropertyPlan& plan, void* ptrToProp) {
+	return MakeShareable(new FJsonValueString(*static_cast<FString*>(ptrToProp)));
+}
+
+void jsonToString(const FPropertyPlan& plan, const TSharedPtr<FJsonValue>& json, void* ptrToProp) {
+	*static_cast<FString*>(ptrToProp) = json->AsString();
+}
+
+TSharedPtr<FJsonValue> floatToJson(const FPropertyPlan& plan, void* ptrToProp) {
+	return MakeShareable(new FJsonValueNumber(*static_cast<float*>(ptrToProp)));
+}
+
+void jsonToFloat(const FPropertyPlan& plan, const TSharedPtr<FJsonValue>& json, void* ptrToProp) {
+	*static_cast<float*>(ptrToProp) = json->AsNumber();
+}
+
+TSharedPtr<FJsonValue> intToJson(const FPropertyPlan& plan, void* ptrToProp) {
+	return MakeShareable(new FJsonValueNumber(*static_cast<int32*>(ptrToProp)));
+}
+
+void jsonToInt(const FPropertyPlan& plan, const TSharedPtr<FJsonValue>& json, void* ptrToProp) {
+	*static_cast<int32*>(ptrToProp) = json->AsNumber();
+}
+
+//bool properties can be bitfields, so they have to go through the property itself
+TSharedPtr<FJsonValue> boolToJson(const FPropertyPlan& plan, void* ptrToProp) {
+	return MakeShareable(new FJsonValueBoolean(static_cast<UBoolProperty*>(plan.property)->GetPropertyValue(ptrToProp)));
+}
+
+void jsonToBool(const FPropertyPlan& plan, const TSharedPtr<FJsonValue>& json, void* ptrToProp) {
+	static_cast<UBoolProperty*>(plan.property)->SetPropertyValue(ptrToProp, json->AsBool());
+}
+
+TSharedPtr<FJsonValue> arrayToJson(const FPropertyPlan& plan, void* ptrToProp) {
+	FScriptArrayHelper arrayHelper(static_cast<UArrayProperty*>(plan.property), ptrToProp);
+	const FPropertyPlan& innerPlan = *plan.innerPlan;
+	TArray<TSharedPtr<FJsonValue>> jsonArr;
+	jsonArr.Reserve(arrayHelper.Num());
+	for (int32 i = 0; i < arrayHelper.Num(); i++) {
+		jsonArr.Add(innerPlan.toJson(innerPlan, arrayHelper.GetRawPtr(i)));
+	}
+	return MakeShareable(new FJsonValueArray(jsonArr));
+}
+
+void jsonToArray(const FPropertyPlan& plan, const TSharedPtr<FJsonValue>& json, void* ptrToProp) {
+	FScriptArrayHelper arrayHelper(static_cast<UArrayProperty*>(plan.property), ptrToProp);
+	const FPropertyPlan& innerPlan = *plan.innerPlan;
+	const TArray<TSharedPtr<FJsonValue>>& jsonArr = json->AsArray();
+	//array helper constructs and destructs elements properly, unlike raw script array resizing
+	arrayHelper.Resize(jsonArr.Num());
+	for (int32 i = 0; i < jsonArr.Num(); i++) {
+		innerPlan.fromJson(innerPlan, jsonArr[i], arrayHelper.GetRawPtr(i));
 	}
 }
 
-inline TSharedPtr<FJsonValue> USMLBlueprintLibrary::convertUPropToJsonValue(UProperty* prop, void* ptrToProp) {
-	if (auto strProp = Cast<UStrProperty>(prop)) {
-		return TSharedPtr<FJsonValue>(new FJsonValueString(strProp->GetPropertyValue(ptrToProp)));
-	} else if (auto fProp = Cast<UFloatProperty>(prop)) {
-		return TSharedPtr<FJsonValue>(new FJsonValueNumber(fProp->GetPropertyValue(ptrToProp)));
-	} else if (auto iProp = Cast<UIntProperty>(prop)) {
-		return TSharedPtr<FJsonValue>(new FJsonValueNumber(iProp->GetPropertyValue(ptrToProp)));
-	} else if (auto bProp = Cast<UBoolProperty>(prop)) {
-		return TSharedPtr<FJsonValue>(new FJsonValueBoolean(bProp->GetPropertyValue(ptrToProp)));
+TSharedPtr<FJsonValue> structToJson(const FPropertyPlan& plan, void* ptrToProp) {
+	const TSharedRef<const FStructPlan> structPlan = getStructPlan(static_cast<UStructProperty*>(plan.property)->Struct);
+	return MakeShareable(new FJsonValueObject(structToJsonObject(*structPlan, ptrToProp)));
+}
+
+void jsonToStruct(const FPropertyPlan& plan, const TSharedPtr<FJsonValue>& json, void* ptrToProp) {
+	const TSharedRef<const FStructPlan> structPlan = getStructPlan(static_cast<UStructProperty*>(plan.property)->Struct);
+	jsonObjectToStruct(*structPlan, json->AsObject(), ptrToProp);
+}
+
+TSharedPtr<FJsonValue> unsupportedToJson(const FPropertyPlan& plan, void* ptrToProp) {
+	return MakeShareable(new FJsonValueNull());
+}
+
+void jsonToUnsupported(const FPropertyPlan& plan, const TSharedPtr<FJsonValue>& json, void* ptrToProp) {}
+
+FPropertyPlan makePropertyPlan(UProperty* prop) {
+	if (prop->IsA<UStrProperty>()) {
+		return FPropertyPlan{ prop, &stringToJson, &jsonToString };
+	} else if (prop->IsA<UFloatProperty>()) {
+		return FPropertyPlan{ prop, &floatToJson, &jsonToFloat };
+	} else if (prop->IsA<UIntProperty>()) {
+		return FPropertyPlan{ prop, &intToJson, &jsonToInt };
+	} else if (prop->IsA<UBoolProperty>()) {
+		return FPropertyPlan{ prop, &boolToJson, &jsonToBool };
 	} else if (auto aProp = Cast<UArrayProperty>(prop)) {
-		auto& arr = aProp->GetPropertyValue(ptrToProp);
-		TArray<TSharedPtr<FJsonValue>> jsonArr;
-		for (int i = 0; i < arr.Num(); i++) {
-			jsonArr.Add(convertUPropToJsonValue(aProp->Inner, (void*)((size_t)arr.GetData() + i * aProp->Inner->ElementSize)));
+		return FPropertyPlan{ prop, &arrayToJson, &jsonToArray, MakeShareable(new FPropertyPlan(makePropertyPlan(aProp->Inner))) };
+	} else if (prop->IsA<UStructProperty>()) {
+		//nested struct plans are resolved when used, so self-referencing structs don't recurse here
+		return FPropertyPlan{ prop, &structToJson, &jsonToStruct };
+	}
+	return FPropertyPlan{ prop, &unsupportedToJson, &jsonToUnsupported };
+}
+
+TSharedPtr<FJsonObject> USMLBlueprintLibrary::convertUStructToJsonObject(UStruct* Struct, void* ptrToStruct) {
+	return structToJsonObject(*getStructPlan(Struct), ptrToStruct);
+}
+
+void USMLBlueprintLibrary::convertJsonObjectToUStruct(TSharedPtr<FJsonObject> json, UStruct* Struct, void* ptrToStruct) {
+	jsonObjectToStruct(*getStructPlan(Struct), json, ptrToStruct);
+}
+
+TArray<TSharedPtr<FJsonValue>> USMLBlueprintLibrary::convertUStructArrayToJsonArray(UStruct* Struct, void* ptrToFirstStruct, int32 count) {
+	const TSharedRef<const FStructPlan> plan = getStructPlan(Struct);
+	const int32 structSize = Struct->GetStructureSize();
+	TArray<TSharedPtr<FJsonValue>> jsonArr;
+	jsonArr.Reserve(count);
+	for (int32 i = 0; i < count; i++) {
+		jsonArr.Add(MakeShareable(new FJsonValueObject(structToJsonObject(*plan, static_cast<uint8*>(ptrToFirstStruct) + i * structSize))));
+	}
+	return jsonArr;
+}
+
+void USMLBlueprintLibrary::convertJsonArrayToUStructArray(const TArray<TSharedPtr<FJsonValue>>& json, UStruct* Struct, void* ptrToFirstStruct, int32 count) {
+	const TSharedRef<const FStructPlan> plan = getStructPlan(Struct);
+	const int32 structSize = Struct->GetStructureSize();
+	const int32 convertCount = FMath::Min(count, json.Num());
+	for (int32 i = 0; i < convertCount; i++) {
+		const TSharedPtr<FJsonObject>* object;
+		if (json[i].IsValid() && json[i]->TryGetObject(object)) {
+			jsonObjectToStruct(*plan, *object, static_cast<uint8*>(ptrToFirstStruct) + i * structSize);
 		}
-		return TSharedPtr<FJsonValue>(new FJsonValueArray(jsonArr));
-	} else if (auto sProp = Cast<UStructProperty>(prop)) {
-		return TSharedPtr<FJsonValue>(new FJsonValueObject(convertUStructToJsonObject(sProp->Struct, ptrToProp)));
-	} else return TSharedPtr<FJsonValue>(new FJsonValueNull());
+	}
+}
+
+void USMLBlueprintLibrary::convertJsonValueToUProperty(TSharedPtr<FJsonValue> json, UProperty* prop, void* ptrToProp) {
+	const FPropertyPlan plan = makePropertyPlan(prop);
+	plan.fromJson(plan, json, ptrToProp);
+}
+
+TSharedPtr<FJsonValue> USMLBlueprintLibrary::convertUPropToJsonValue(UProperty* prop, void* ptrToProp) {
+	const FPropertyPlan plan = makePropertyPlan(prop);
+	return plan.toJson(plan, ptrToProp);
 }
 
 void USMLBlueprintLibrary::LogDebug(const FString& str, bool ignoreDebugMode) {
-	if (ignoreDebugMode) SML::Logging::log(SML::Logging::LogType::Debug, *str);
-	else SML::Logging::debug(*str);
+	if (ignoreDebugMode) SML::Logging::logCategory(LogSMLBlueprint, SML::Logging::LogType::Debug, *str);
+	else SML_LOG_DEBUG(LogSMLBlueprint, *str);
 }
 
 void USMLBlueprintLibrary::LogWarning(const FString& str) {
@@ -15,6 +15,18 @@ public:
 	static void convertJsonObjectToUStruct(TSharedPtr<FJsonObject> json, UStruct* Struct, void* ptrToStruct);
 	static void convertJsonValueToUProperty(TSharedPtr<FJsonValue> json, UProperty* prop, void* ptrToProp);
 
+	/**
+	 * Converts count structs laid out contiguously starting at ptrToFirstStruct, like TArray elements,
+	 * reusing the same cached conversion plan of the struct for all of them
+	 */
+	static TArray<TSharedPtr<FJsonValue>> convertUStructArrayToJsonArray(UStruct* Struct, void* ptrToFirstStruct, int32 count);
+
+	/**
+	 * Fills up to count contiguously laid out structs from the json objects of the given array
+	 * Elements that are not json objects are skipped, leaving their structs unchanged
+	 */
+	static void convertJsonArrayToUStructArray(const TArray<TSharedPtr<FJsonValue>>& json, UStruct* Struct, void* ptrToFirstStruct, int32 count);
+
 	/**
 	 * Logs the given string in debug level to the SML Log file and the game log as well as into the console
 	 * @param str - the string you want to log
@@ -15,6 +15,7 @@
 #include "hooking.h"
 #include "FGPlayerController.h"
 #include "ModHandlerInternal.h"
+#include "util/StartupProfiler.h"
 
 using namespace SML;
 using namespace Mod;
@@ -53,9 +54,11 @@ FModHandler::FModHandler() {}
 TMap<FString, HLOADEDMODULE> loadedModuleDlls;
 
 void FModHandler::loadDllMods(const BootstrapAccessors& accessors) {
+	SML_STARTUP_TIMER(TEXT("loadDllMods"));
 	for (auto& loadingEntry : sortedModLoadList) {
 		const FString& modid = loadingEntry.modInfo.modid;
 		if (loadingEntry.dllFilePath.Len() > 0) {
+			SML_STARTUP_TIMER(FString::Printf(TEXT("LoadModule %s"), *modid));
 			HLOADEDMODULE module = accessors.LoadModule("", *loadingEntry.dllFilePath);
 			if (module == nullptr) SML::shutdownEngine(FString::Printf(TEXT("Module failed to load: %s"), *loadingEntry.dllFilePath));
 			loadedModuleDlls.Add(modid, module);
@@ -64,6 +67,7 @@ void FModHandler::loadDllMods(const BootstrapAccessors& accessors) {
 }
 
 void FModHandler::LoadModLibraries(const BootstrapAccessors& accessors, TMap<FString, IModuleInterface*>& loadedModules) {
+	SML_STARTUP_TIMER(TEXT("LoadModLibraries"));
 	TMap<FString, FName> registeredModules;
 	
 	//register SML module manually as it is already loaded into the process
@@ -75,6 +79,7 @@ void FModHandler::LoadModLibraries(const BootstrapAccessors& accessors, TMap<FSt
 	for (auto& pair : loadedModuleDlls) {
 		const FString& modid = pair.Key;
 		const HLOADEDMODULE loadedModule = pair.Value;
+		SML_STARTUP_TIMER(FString::Printf(TEXT("InitializeModule %s"), *modid));
 		void* rawInitPtr = accessors.GetModuleProcAddress(loadedModule, "InitializeModule");
 		const FInitializeModuleFunctionPtr initModule = static_cast<FInitializeModuleFunctionPtr>(rawInitPtr);
 		if (initModule == nullptr) {
@@ -109,6 +114,7 @@ void FModHandler::PopulateModList(const TMap<FString, IModuleInterface*>& loaded
 }
 
 void FModHandler::MountModPaks() {
+	SML_STARTUP_TIMER(TEXT("MountModPaks"));
 	FPakPlatformFile* pakPlatformFile = static_cast<FPakPlatformFile*>(FPlatformFileManager::Get().FindPlatformFile(TEXT("PakFile")));
 	TArray<FString> mountedPakNames;
 	pakPlatformFile->GetMountedPakFilenames(mountedPakNames);
@@ -116,6 +122,7 @@ void FModHandler::MountModPaks() {
 	const FString gamePakSignaturePath = FPaths::ChangeExtension(platformPakFileName, TEXT("sig"));
 	
 	for (auto& loadingEntry : sortedModLoadList) {
+		SML_STARTUP_TIMER(FString::Printf(TEXT("MountModPaks %s"), *loadingEntry.modInfo.modid));
 		for (auto& pakFileDef : loadingEntry.pakFiles) {
 			FString pakFilePathStr = pakFileDef.pakFilePath;
 			FString modPakSignaturePath = FPaths::ChangeExtension(pakFilePathStr, TEXT("sig"));
@@ -144,6 +151,9 @@ void FModHandler::loadMods(const BootstrapAccessors& accessors) {
 
 	SML::Logging::info("Mounting mod paks...");
 	MountModPaks();
+
+	modSetDigest = computeModSetDigest(loadedModsList);
+	SML::Logging::info(TEXT("Mod set digest: "), *modSetDigest);
 	
 	checkStageErrors(TEXT("mod initialization"));
 }
@@ -157,15 +167,16 @@ public: const FString* Find(const FName&) { return nullptr; }
 void FModHandler::attachLoadingHooks() {
 	SUBSCRIBE_METHOD("?InitGameState@AFGGameMode@@UEAAXXZ", AFGGameMode::InitGameState, [](auto& scope, AFGGameMode* gameMode) {
 		//only call initializers on host worlds
-		SML::Logging::debug(TEXT("AFGGameMode::InitGameState on map "), *gameMode->GetWorld()->GetMapName());
+		SML_LOG_DEBUG(SML::Logging::LogSML, TEXT("AFGGameMode::InitGameState on map "), *gameMode->GetWorld()->GetMapName());
 		if (gameMode->HasAuthority()) {
 			SML::getModHandler().onGameModePostLoad(gameMode);
 			SML::getModHandler().initializeModActors();
 			SML::Logging::info(TEXT("Finished initializing mod actors"));
+			SML::Profiling::writeStartupReport();
 		}
 	});
 	SUBSCRIBE_METHOD("?BeginPlay@AFGPlayerController@@UEAAXXZ", AFGPlayerController::BeginPlay, [](auto& scope, AFGPlayerController* controller) {
-		SML::Logging::debug(TEXT("AFGPlayerController::BeginPlay on "), GetData(controller->GetWorld()->GetMapName()));
+		SML_LOG_DEBUG(SML::Logging::LogSML, TEXT("AFGPlayerController::BeginPlay on "), GetData(controller->GetWorld()->GetMapName()));
 		//only call initializers on host worlds
 		AFGGameMode* gameMode = static_cast<AFGGameMode*>(controller->GetWorld()->GetGameState<AGameStateBase>()->AuthorityGameMode);
 		if (gameMode != nullptr && gameMode->HasAuthority()) {
@@ -217,26 +228,28 @@ void FModHandler::initializeMenuActors() {
 			if (initMenu) {
 				SML::Logging::info(TEXT("Initializing menu of mod "), *actor->GetClass()->GetPathName());
 				initMenu->Init();
-				SML::Logging::debug(TEXT("Done initializing menu of mod "), *actor->GetClass()->GetPathName());
+				SML_LOG_DEBUG(SML::Logging::LogSML, TEXT("Done initializing menu of mod "), *actor->GetClass()->GetPathName());
 			}
 		}
 	}
-	SML::Logging::debug(TEXT("Done initializing mod content packages"));
+	SML_LOG_DEBUG(SML::Logging::LogSML, TEXT("Done initializing mod content packages"));
 }
 
 void FModHandler::initializeModActors() {
+	SML_STARTUP_TIMER(TEXT("initializeModActors"));
 	SML::Logging::info(TEXT("Initializing mod content packages..."));
 	for (AActor* actor : this->modInitializerActorList) {
 		if (actor != nullptr) {
 			ASMLInitMod* initMod = Cast<ASMLInitMod>(actor);
 			if (initMod) {
+				SML_STARTUP_TIMER(FString::Printf(TEXT("initializeModActors %s"), *actor->GetClass()->GetPathName()));
 				SML::Logging::info(TEXT("Initializing mod "), *actor->GetClass()->GetPathName());
 				initMod->Init();
-				SML::Logging::debug(TEXT("Done initializing mod "), *actor->GetClass()->GetPathName());
+				SML_LOG_DEBUG(SML::Logging::LogSML, TEXT("Done initializing mod "), *actor->GetClass()->GetPathName());
 			}
 		}
 	}
-	SML::Logging::debug(TEXT("Done initializing mod content packages"));
+	SML_LOG_DEBUG(SML::Logging::LogSML, TEXT("Done initializing mod content packages"));
 }
 
 void FModHandler::postInitializeModActors() {
@@ -248,14 +261,15 @@ void FModHandler::postInitializeModActors() {
 				SML::Logging::info(TEXT("Post-initializing mod "), *actor->GetClass()->GetPathName());
 				initMod->LoadSchematics();
 				initMod->PostInit();
-				SML::Logging::debug(TEXT("Done post-initializing mod "), *actor->GetClass()->GetPathName());
+				SML_LOG_DEBUG(SML::Logging::LogSML, TEXT("Done post-initializing mod "), *actor->GetClass()->GetPathName());
 			}
 		}
 	}
-	SML::Logging::debug(TEXT("Done post-initializing mod content packages"));
+	SML_LOG_DEBUG(SML::Logging::LogSML, TEXT("Done post-initializing mod content packages"));
 }
 
 void FModHandler::checkDependencies() {
+	SML_STARTUP_TIMER(TEXT("checkDependencies"));
 	TArray<FModLoadingEntry> allLoadingEntries;
 	TMap<FString, uint64_t> modIndices;
 	TMap<uint64_t, FString> modByIndex;
@@ -293,7 +307,12 @@ void FModHandler::checkDependencies() {
 	try {
 		sortedIndices = SML::TopologicalSort::topologicalSort(sortGraph);
 	} catch (SML::TopologicalSort::cycle_detected<uint64_t>& ex) {
-		FString message = FString::Printf(TEXT("Cycle dependency found in sorting graph at modid: %s"), *modByIndex[ex.cycleNode]);
+		TArray<FString> cycleModIds;
+		for (uint64_t modIndex : ex.cyclePath) {
+			cycleModIds.Add(modByIndex[modIndex]);
+		}
+		cycleModIds.Add(modByIndex[ex.cycleNode]);
+		FString message = FString::Printf(TEXT("Cycle dependency found in sorting graph: %s"), *FString::Join(cycleModIds, TEXT(" -> ")));
 		loadingProblems.Add(message);
 		SML::Logging::error(*message);
 		return;
@@ -307,13 +326,16 @@ void FModHandler::checkDependencies() {
 
 
 void FModHandler::discoverMods() {
+	SML_STARTUP_TIMER(TEXT("discoverMods"));
 	loadingEntries.Add(TEXT("SML"), createSMLLoadingEntry());
 	FString modsPath = SML::getModDirectory();
-	auto directoryVisitor = MakeDirectoryVisitor([this](const TCHAR* filepath, bool isDir) {
+	TArray<FZipModReadResult> zipMods;
+	auto directoryVisitor = MakeDirectoryVisitor([this, &zipMods](const TCHAR* filepath, bool isDir) {
 		if (!isDir) {
 			if (FPaths::GetExtension(filepath) == TEXT("smod") ||
 				FPaths::GetExtension(filepath) == TEXT("zip")) {
-				constructZipMod(filepath);
+				FZipModReadResult& readResult = zipMods.AddDefaulted_GetRef();
+				readResult.filePath = filepath;
 			}
 			else if (FPaths::GetExtension(filepath) == TEXT("dll")) {
 				constructDllMod(filepath);
@@ -324,37 +346,43 @@ void FModHandler::discoverMods() {
 		return true;
 	});
 	FPlatformFileManager::Get().GetPlatformFile().IterateDirectory(*modsPath, directoryVisitor);
+	//zip archives are independent, so read their data.json concurrently, then register them serially
+	//to keep duplicate detection deterministic, and only then inflate objects of the registered ones
+	parallelForEach(zipMods.Num(), [&zipMods](int32 index) {
+		readZipModInfo(zipMods[index]);
+	});
+	for (FZipModReadResult& readResult : zipMods) {
+		registerZipMod(readResult);
+	}
+	parallelForEach(zipMods.Num(), [&zipMods](int32 index) {
+		if (zipMods[index].isRegistered) {
+			extractZipModObjects(zipMods[index]);
+		}
+	});
+	for (const FZipModReadResult& readResult : zipMods) {
+		constructZipMod(readResult);
+	}
 	checkStageErrors(TEXT("mod discovery"));
 };
 
-void FModHandler::constructZipMod(const FString& filePath) {
-	SML::Logging::debug(TEXT("Constructing zip mod from "), *filePath);
-	ttvfs::Root vfs;
-	vfs.AddLoader(new ttvfs::DiskLoader);
-	vfs.AddArchiveLoader(new ttvfs::VFSZipArchiveLoader);
-	auto modArchive = vfs.AddArchive(TCHAR_TO_ANSI(*filePath));
-	if (modArchive == nullptr) {
-		reportBrokenZipMod(filePath, TEXT("corrupted zip file"));
+void FModHandler::registerZipMod(FZipModReadResult& readResult) {
+	if (!readResult.failureReason.IsEmpty()) {
 		return;
 	}
-	ttvfs::File* dataJson = modArchive->getFile("data.json");
-	if (dataJson == nullptr) {
-		reportBrokenZipMod(filePath, TEXT("data.json entry is missing in zip"));
-		return;
-	}
-	FModInfo modInfo;
-	const TSharedPtr<FJsonObject>& dataJsonObj = readArchiveJson(dataJson);
-	if (!dataJsonObj.IsValid() || !FModInfo::isValid(*dataJsonObj.Get(), filePath)) {
-		reportBrokenZipMod(filePath, TEXT("Invalid data.json"));
+	const FModLoadingEntry& loadingEntry = createLoadingEntry(readResult.loadingEntry.modInfo, readResult.filePath);
+	readResult.isRegistered = loadingEntry.isValid;
+}
+
+void FModHandler::constructZipMod(const FZipModReadResult& readResult) {
+	if (!readResult.failureReason.IsEmpty()) {
+		reportBrokenZipMod(readResult.filePath, readResult.failureReason);
 		return;
 	}
-	modInfo = FModInfo::createFromJson(*dataJsonObj.Get());
-	FModLoadingEntry& loadingEntry = createLoadingEntry(modInfo, filePath);
-	if (!loadingEntry.isValid) return;
-	if (!extractArchiveObjects(*modArchive, *dataJsonObj.Get(), loadingEntry)) {
-		FString message = TEXT("Failed to extract data objects");
-		reportBrokenZipMod(filePath, message);
-	}
+	if (!readResult.isRegistered) return;
+	const FModLoadingEntry& readEntry = readResult.loadingEntry;
+	FModLoadingEntry& loadingEntry = loadingEntries[readEntry.modInfo.modid];
+	loadingEntry.dllFilePath = readEntry.dllFilePath;
+	loadingEntry.pakFiles = readEntry.pakFiles;
 }
 
 void FModHandler::constructDllMod(const FString& filePath) {
@@ -377,6 +405,10 @@ const TArray<FString>& FModHandler::getLoadedMods() const {
 	return loadedModsModIDs;
 }
 
+const FString& FModHandler::getModSetDigest() const {
+	return modSetDigest;
+}
+
 bool FModHandler::isModLoaded(const FString& modId) const {
 	return loadedMods.Find(modId) != nullptr;
 }
@@ -28,6 +28,21 @@ namespace SML {
 			bool isRawMod = false;
 		};
 
+		/**
+		 * Result of reading a zip mod archive, possibly on a worker thread
+		 * Holds a detached loading entry with extracted objects,
+		 * or a failure reason if the archive is broken
+		 * Archive is read in two passes: data.json first, then objects are extracted
+		 * only for archives which passed duplicate mod detection
+		 */
+		struct FZipModReadResult {
+			FString filePath;
+			FString failureReason;
+			TSharedPtr<FJsonObject> dataJson;
+			FModLoadingEntry loadingEntry;
+			bool isRegistered = false;
+		};
+
 		struct FModContainer {
 			const FModInfo modInfo;
 			IModuleInterface* moduleInterface;
@@ -54,6 +69,7 @@ namespace SML {
 			TArray<FModContainer*> loadedModsList;
 			TArray<FString> loadedModsModIDs;
 			TArray<AActor*> modInitializerActorList;
+			FString modSetDigest;
 		public:
 			//we shouldn't be able to copy FModHandler, or move it
 			FModHandler(FModHandler&) = delete; //delete copy constructor
@@ -72,6 +88,12 @@ namespace SML {
 			* Returns a map of all loaded mod ids
 			*/
 			const TArray<FString>& getLoadedMods() const;
+
+			/**
+			* Returns digest of the loaded mod ids and versions, computed once mods are loaded
+			* Equal digests mean exactly the same mods with exactly the same versions
+			*/
+			const FString& getModSetDigest() const;
 		private:
 			FModLoadingEntry& createRawModLoadingEntry(const FString& modId, const FString& filePath);
 			FModLoadingEntry& createLoadingEntry(const FModInfo& modInfo, const FString& filePath);
@@ -80,7 +102,8 @@ namespace SML {
 			void reportBrokenZipMod(const FString& filePath, const FString& reason);
 			void checkStageErrors(const  TCHAR* stageName);
 			
-			void constructZipMod(const FString& filePath);
+			void registerZipMod(FZipModReadResult& readResult);
+			void constructZipMod(const FZipModReadResult& readResult);
 			void constructPakMod(const FString& filePath);
 			void constructDllMod(const FString& filePath);
 
@@ -7,6 +7,13 @@
 #include "GameFramework/Actor.h"
 #include "actor/SMLInitMod.h"
 #include "actor/SMLInitMenu.h"
+#include "zip/ttvfs_zip/ttvfs_zip.h"
+#include "util/CacheManager.h"
+#include "util/StartupProfiler.h"
+#include "util/JsonStreamReader.h"
+#include "Misc/ScopeLock.h"
+#include <thread>
+#include <atomic>
 
 void iterateDependencies(TMap<FString, FModLoadingEntry>& loadingEntries,
 	TMap<FString, uint64_t>& modIndices,
@@ -25,7 +32,7 @@ void finalizeSortingResults(TMap<uint64_t, FString>& modByIndex,
 		const FModLoadingEntry& loadingEntry = loadingEntries[modByIndex[modIndex]];
 		auto dependencies = loadingEntry.modInfo.dependencies;
 		if (dependencies.Find(TEXT("@ORDER:LAST")) != nullptr)
-			modsToMoveInTheEnd.Add(i);
+			modsToMoveInTheEnd.Add(modIndex);
 	}
 	for (auto& modIndex : modsToMoveInTheEnd) {
 		sortedIndices.Remove(modIndex);
@@ -102,8 +109,23 @@ FileHash hashFileContents(const FString& path) {
 	return picosha2::bytes_to_hex_string(hash);
 }
 
+FString computeModSetDigest(const TArray<FModContainer*>& loadedModsList) {
+	TArray<FString> modEntries;
+	for (const FModContainer* modContainer : loadedModsList) {
+		modEntries.Add(modContainer->modInfo.modid.ToLower() + TEXT("=") + modContainer->modInfo.version.string());
+	}
+	modEntries.Sort([](const FString& a, const FString& b) { return a.Compare(b, ESearchCase::CaseSensitive) < 0; });
+	const FTCHARToUTF8 digestInput(*FString::Join(modEntries, TEXT("\n")));
+	std::vector<unsigned char> hash(picosha2::k_digest_size);
+	picosha2::hash256(digestInput.Get(), digestInput.Get() + digestInput.Length(), hash.begin(), hash.end());
+	//128 bits are plenty to tell mod sets apart, and keep connection url shorter
+	return FString(picosha2::bytes_to_hex_string(hash.begin(), hash.begin() + 16).c_str());
+}
+
 FString generateTempFilePath(const FileHash& fileHash, const char* fileName) {
-	FString dir = SML::getCacheDirectory() / FString(fileHash.c_str());
+	const FString entryName = FString(fileHash.c_str());
+	SML::Cache::markCacheEntryUsed(entryName);
+	FString dir = SML::getCacheDirectory() / entryName;
 	FPlatformFileManager::Get().GetPlatformFile().CreateDirectoryTree(*dir);
 	return dir / fileName;
 }
@@ -133,59 +155,89 @@ TSharedPtr<FJsonObject> readArchiveJson(ttvfs::File* obj) {
 	std::vector<char> buffer(obj->size());
 	obj->read(buffer.data(), obj->size());
 	obj->close();
-	const FString string(std::string(buffer.begin(), buffer.end()).c_str());
-	try {
-		return parseJsonLenient(string);
-	} catch (const std::exception& ex) {
-		SML::Logging::error(*FString::Printf(TEXT("Failed to parse data.json from archive object %s: %s"), obj->name(), ex.what()));
-		return TSharedPtr<FJsonObject>();
+	//parse UTF-8 contents directly instead of widening them into the FString first
+	FString errorMessage;
+	const TSharedPtr<FJsonObject> result = SML::JsonStream::parseJsonObject(buffer.data(), buffer.size(), &errorMessage);
+	if (!result.IsValid()) {
+		SML::Logging::error(TEXT("Failed to parse data.json from archive object "), obj->name(), TEXT(": "), *errorMessage);
 	}
+	return result;
 }
 
-bool hashArchiveFileContents(ttvfs::File* obj, FileHash& outHash) {
+bool readArchiveFileContents(ttvfs::File* obj, std::vector<char>& outBuffer) {
 	if (!obj->open("rb")) {
 		SML::Logging::error(TEXT("Failed opening archive object"));
 		return false;
 	}
-	std::vector<char> buffer(obj->size());
-	obj->read(buffer.data(), obj->size());
+	outBuffer.resize(obj->size());
+	obj->read(outBuffer.data(), outBuffer.size());
 	obj->close();
+	return true;
+}
 
+FileHash hashBufferContents(const std::vector<char>& buffer) {
 	std::vector<unsigned char> hash(picosha2::k_digest_size);
 	picosha2::hash256(buffer.begin(), buffer.end(), hash.begin(), hash.end());
-	outHash = picosha2::bytes_to_hex_string(hash);
+	return picosha2::bytes_to_hex_string(hash);
+}
+
+bool writeBufferToFile(const FString& outFilePath, const std::vector<char>& buffer) {
+	std::ofstream outFile(*outFilePath, std::ofstream::binary);
+	if (!outFile.is_open()) {
+		SML::Logging::error(TEXT("Failed opening file for writing "), *outFilePath);
+		return false;
+	}
+	outFile.write(buffer.data(), buffer.size());
+	outFile.close();
 	return true;
 }
 
-bool extractFixedNameFileInternal(ttvfs::File* objectFile, const FString& filePath) {
-	FileHash fileHash;
-	if (!hashArchiveFileContents(objectFile, fileHash)) {
+bool hashArchiveFileContents(ttvfs::File* obj, FileHash& outHash) {
+	std::vector<char> buffer;
+	if (!readArchiveFileContents(obj, buffer)) {
 		return false;
 	}
+	outHash = hashBufferContents(buffer);
+	return true;
+}
+
+//archives are extracted concurrently, and different archives can contain identical objects,
+//which end up in the same cache file. Writes are serialized per path by one of the striped locks
+static FCriticalSection cacheFileLocks[32];
+
+FCriticalSection& getCacheFileLock(const FString& filePath) {
+	return cacheFileLocks[GetTypeHash(filePath) % ARRAY_COUNT(cacheFileLocks)];
+}
+
+//inflates archive object only once, and reuses the buffer for both hashing and writing
+bool extractCachedFileInternal(const std::vector<char>& buffer, const FileHash& fileHash, const FString& filePath) {
+	FScopeLock lock(&getCacheFileLock(filePath));
 	//if cached file doesn't exist, or file hashes don't match, unpack file and copy it
 	if (!FPaths::FileExists(filePath) || fileHash != hashFileContents(filePath)) {
 		//in case of broken cache file, remove old file
 		FPlatformFileManager::Get().GetPlatformFile().DeleteFile(*filePath);
-		//unpack file in the temporary directory
-		return extractArchiveFile(filePath, objectFile);
+		//write already unpacked contents in the temporary directory
+		return writeBufferToFile(filePath, buffer);
 	}
 	return true;
 }
 
+bool extractFixedNameFileInternal(ttvfs::File* objectFile, const FString& filePath) {
+	std::vector<char> buffer;
+	if (!readArchiveFileContents(objectFile, buffer)) {
+		return false;
+	}
+	return extractCachedFileInternal(buffer, hashBufferContents(buffer), filePath);
+}
+
 bool extractTempFileInternal(ttvfs::File* objectFile, const std::string& objectType, FString& filePath) {
-	FileHash fileHash;
-	if (!hashArchiveFileContents(objectFile, fileHash)) {
+	std::vector<char> buffer;
+	if (!readArchiveFileContents(objectFile, buffer)) {
 		return false;
 	}
+	const FileHash fileHash = hashBufferContents(buffer);
 	filePath = generateTempFilePath(fileHash, objectFile->name());
-	//if cached file doesn't exist, or file hashes don't match, unpack file and copy it
-	if (!FPaths::FileExists(filePath) || fileHash != hashFileContents(filePath)) {
-		//in case of broken cache file, remove old file
-		FPlatformFileManager::Get().GetPlatformFile().DeleteFile(*filePath);
-		//unpack file in the temporary directory
-		return extractArchiveFile(filePath, objectFile);
-	}
-	return true;
+	return extractCachedFileInternal(buffer, fileHash, filePath);
 }
 
 bool extractArchiveObject(ttvfs::Dir& root, const std::string& objectType, const std::string& archivePath, SML::Mod::FModLoadingEntry& loadingEntry, const FJsonObject* metadata) {
@@ -199,6 +251,7 @@ bool extractArchiveObject(ttvfs::Dir& root, const std::string& objectType, const
 	if (objectType == "config") {
 		//extract mod configuration into the predefined folder
 		FString configFilePath = getModConfigFilePath(loadingEntry.modInfo.modid);
+		FScopeLock lock(&getCacheFileLock(configFilePath));
 		if (!FPaths::FileExists(configFilePath)) {
 			//only extract it if it doesn't exist already
 			return extractArchiveFile(configFilePath, objectFile);
@@ -297,6 +350,78 @@ void iterateDependencies(TMap<FString, FModLoadingEntry>& loadingEntries,
 	}
 }
 
+ttvfs::Dir* openZipModArchive(ttvfs::Root& vfs, const FString& filePath) {
+	vfs.AddLoader(new ttvfs::DiskLoader);
+	vfs.AddArchiveLoader(new ttvfs::VFSZipArchiveLoader);
+	return vfs.AddArchive(TCHAR_TO_ANSI(*filePath));
+}
+
+void readZipModInfo(FZipModReadResult& readResult) {
+	const FString& filePath = readResult.filePath;
+	SML_LOG_DEBUG(SML::Logging::LogSML, TEXT("Constructing zip mod from "), *filePath);
+	ttvfs::Root vfs;
+	auto modArchive = openZipModArchive(vfs, filePath);
+	if (modArchive == nullptr) {
+		readResult.failureReason = TEXT("corrupted zip file");
+		return;
+	}
+	ttvfs::File* dataJson = modArchive->getFile("data.json");
+	if (dataJson == nullptr) {
+		readResult.failureReason = TEXT("data.json entry is missing in zip");
+		return;
+	}
+	const TSharedPtr<FJsonObject>& dataJsonObj = readArchiveJson(dataJson);
+	if (!dataJsonObj.IsValid() || !FModInfo::isValid(*dataJsonObj.Get(), filePath)) {
+		readResult.failureReason = TEXT("Invalid data.json");
+		return;
+	}
+	readResult.dataJson = dataJsonObj;
+	FModLoadingEntry& loadingEntry = readResult.loadingEntry;
+	loadingEntry.isValid = true;
+	loadingEntry.modInfo = FModInfo::createFromJson(*dataJsonObj.Get());
+	loadingEntry.virtualModFilePath = filePath;
+}
+
+void extractZipModObjects(FZipModReadResult& readResult) {
+	const FString& filePath = readResult.filePath;
+	SML_STARTUP_TIMER(FString::Printf(TEXT("constructZipMod %s"), *FPaths::GetCleanFilename(filePath)));
+	//reopening archive only reads it's central directory, so it is cheaper than keeping every archive open
+	ttvfs::Root vfs;
+	auto modArchive = openZipModArchive(vfs, filePath);
+	if (modArchive == nullptr) {
+		readResult.failureReason = TEXT("corrupted zip file");
+		return;
+	}
+	if (!extractArchiveObjects(*modArchive, *readResult.dataJson.Get(), readResult.loadingEntry)) {
+		readResult.failureReason = TEXT("Failed to extract data objects");
+	}
+}
+
+void parallelForEach(int32 count, const std::function<void(int32)>& func) {
+	const int32 hardwareThreads = FMath::Max(1, static_cast<int32>(std::thread::hardware_concurrency()));
+	const int32 workerCount = FMath::Min(count, hardwareThreads);
+	if (workerCount <= 1) {
+		for (int32 i = 0; i < count; i++) {
+			func(i);
+		}
+		return;
+	}
+	std::atomic<int32> nextIndex(0);
+	std::vector<std::thread> workers;
+	workers.reserve(workerCount);
+	for (int32 i = 0; i < workerCount; i++) {
+		workers.emplace_back([&nextIndex, count, &func]() {
+			int32 index;
+			while ((index = nextIndex++) < count) {
+				func(index);
+			}
+		});
+	}
+	for (std::thread& worker : workers) {
+		worker.join();
+	}
+}
+
 IModuleInterface* InitializeSMLModule() {
 	return new FSMLModule();
 }
\ No newline at end of file
@@ -4,6 +4,7 @@
 #include "zip/ttvfs/ttvfs.h"
 #include "hooking.h"
 #include "util/TopologicalSort.h"
+#include <functional>
 
 using namespace SML;
 using namespace Mod;
@@ -27,6 +28,12 @@ void populateSortedModList(TMap<uint64_t, FString>& modByIndex,
 	TArray<uint64_t>& sortedIndices,
 	TArray<FModLoadingEntry>& sortedModLoadingList);
 
+/**
+ * Computes digest identifying the set of the loaded mods and their exact versions
+ * Mods are sorted by lower case mod id first, so digest doesn't depend on the load order
+ */
+FString computeModSetDigest(const TArray<FModContainer*>& loadedModsList);
+
 IModuleInterface* InitializeSMLModule();
 
 FModPakLoadEntry CreatePakLoadEntry(const FString& modid);
@@ -37,6 +44,8 @@ FString getModIdFromFile(const FString& filePath);
 
 bool extractArchiveFile(const FString& outFilePath, ttvfs::File* obj);
 
+bool readArchiveFileContents(ttvfs::File* obj, std::vector<char>& outBuffer);
+
 TSharedPtr<FJsonObject> readArchiveJson(ttvfs::File* obj);
 
 FileHash hashArchiveFileContents(ttvfs::File* obj);
@@ -44,3 +53,22 @@ FileHash hashArchiveFileContents(ttvfs::File* obj);
 bool extractArchiveObject(ttvfs::Dir& root, const std::string& objectType, const std::string& archivePath, SML::Mod::FModLoadingEntry& loadingEntry, const FJsonObject* metadata);
 
 bool extractArchiveObjects(ttvfs::Dir& root, const FJsonObject& dataJson, SML::Mod::FModLoadingEntry& loadingEntry);
+
+/**
+ * Opens zip mod archive and reads it's data.json into the mod info of the loading entry
+ * Doesn't touch mod handler state, so it is safe to call for different archives concurrently
+ */
+void readZipModInfo(FZipModReadResult& readResult);
+
+/**
+ * Extracts archive objects of the zip mod already read by readZipModInfo into the cache
+ * Writes into the shared cache directory are serialized per destination path,
+ * so it is safe to call for different archives concurrently, even if they contain identical objects
+ */
+void extractZipModObjects(FZipModReadResult& readResult);
+
+/**
+ * Runs func for each index in [0, count) on a pool of worker threads and waits for completion
+ * Uses raw std::thread because task graph is not yet available during bootstrap
+ */
+void parallelForEach(int32 count, const std::function<void(int32)>& func);
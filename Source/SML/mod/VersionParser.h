@@ -0,0 +1,131 @@
+#pragma once
+#include <cstdint>
+
+namespace SML {
+	namespace Versioning {
+		enum EComparisonOp {
+			EQUALS,
+			GREATER,
+			GREATER_EQUALS,
+			LESS,
+			LESS_EQUALS
+		};
+
+		/**
+		 * Allocation free SemVer 2.0.0 parser used by FVersion and FVersionRange
+		 * It doesn't depend on the engine, so Tools/SMLVersionParity can check it against the regex parser used before
+		 */
+		namespace Parser {
+			/**
+			 * Result of parsing a version string, pre-release and build metadata are stored as offsets into the parsed string
+			 */
+			struct FParsedVersion {
+				EComparisonOp op;
+				//length of the comparison operator prefix, 0 if there is none
+				int32_t opLength;
+				uint64_t major;
+				uint64_t minor;
+				uint64_t patch;
+				int32_t typeStart;
+				int32_t typeLength;
+				int32_t buildInfoStart;
+				int32_t buildInfoLength;
+			};
+
+			template<typename CharType>
+			inline bool isDigit(CharType c) {
+				return c >= '0' && c <= '9';
+			}
+
+			template<typename CharType>
+			inline bool isIdentifierChar(CharType c) {
+				return isDigit(c) || (c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z') || c == '-';
+			}
+
+			//reads operator prefix, ^ is accepted but treated as exact match, like it always was
+			template<typename CharType>
+			void parseComparisonOp(const CharType* string, int32_t length, int32_t& pos, EComparisonOp& op) {
+				op = EComparisonOp::EQUALS;
+				if (pos >= length) return;
+				const CharType first = string[pos];
+				const bool hasEquals = pos + 1 < length && string[pos + 1] == '=';
+				if (first == '<') {
+					op = hasEquals ? EComparisonOp::LESS_EQUALS : EComparisonOp::LESS;
+					pos += hasEquals ? 2 : 1;
+				} else if (first == '>') {
+					op = hasEquals ? EComparisonOp::GREATER_EQUALS : EComparisonOp::GREATER;
+					pos += hasEquals ? 2 : 1;
+				} else if (first == '^') {
+					pos++;
+				}
+			}
+
+			//numeric identifier: 0|[1-9]\d*, fails on overflow
+			template<typename CharType>
+			bool parseNumber(const CharType* string, int32_t length, int32_t& pos, uint64_t& outValue) {
+				if (pos >= length || !isDigit(string[pos])) return false;
+				if (string[pos] == '0') {
+					outValue = 0;
+					pos++;
+					return pos >= length || !isDigit(string[pos]);
+				}
+				uint64_t value = 0;
+				while (pos < length && isDigit(string[pos])) {
+					const uint64_t digit = string[pos] - '0';
+					if (value > (UINT64_MAX - digit) / 10) return false;
+					value = value * 10 + digit;
+					pos++;
+				}
+				outValue = value;
+				return true;
+			}
+
+			//dot separated identifiers [0-9a-zA-Z-]+, pre-release ones additionally can't be numeric with leading zeros
+			template<typename CharType>
+			bool parseIdentifiers(const CharType* string, int32_t length, int32_t& pos, bool isPreRelease) {
+				while (true) {
+					const int32_t start = pos;
+					bool allDigits = true;
+					while (pos < length && isIdentifierChar(string[pos])) {
+						allDigits &= isDigit(string[pos]);
+						pos++;
+					}
+					const int32_t identifierLength = pos - start;
+					if (identifierLength == 0) return false;
+					if (isPreRelease && allDigits && identifierLength > 1 && string[start] == '0') return false;
+					if (pos >= length || string[pos] != '.') return true;
+					pos++;
+				}
+			}
+
+			/**
+			 * Parses SemVer version string, optionally prefixed with comparison operator (<=, <, >, >=, ^)
+			 * Returns false if string is not a valid version, leaving outVersion partially filled
+			 */
+			template<typename CharType>
+			bool parseVersion(const CharType* string, int32_t length, FParsedVersion& outVersion) {
+				int32_t pos = 0;
+				parseComparisonOp(string, length, pos, outVersion.op);
+				outVersion.opLength = pos;
+				if (!parseNumber(string, length, pos, outVersion.major)) return false;
+				if (pos >= length || string[pos++] != '.') return false;
+				if (!parseNumber(string, length, pos, outVersion.minor)) return false;
+				if (pos >= length || string[pos++] != '.') return false;
+				if (!parseNumber(string, length, pos, outVersion.patch)) return false;
+				outVersion.typeStart = outVersion.typeLength = 0;
+				outVersion.buildInfoStart = outVersion.buildInfoLength = 0;
+				if (pos < length && string[pos] == '-') {
+					outVersion.typeStart = ++pos;
+					if (!parseIdentifiers(string, length, pos, true)) return false;
+					outVersion.typeLength = pos - outVersion.typeStart;
+				}
+				if (pos < length && string[pos] == '+') {
+					outVersion.buildInfoStart = ++pos;
+					if (!parseIdentifiers(string, length, pos, false)) return false;
+					outVersion.buildInfoLength = pos - outVersion.buildInfoStart;
+				}
+				return pos == length;
+			}
+		}
+	};
+};
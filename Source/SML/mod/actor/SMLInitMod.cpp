@@ -7,9 +7,9 @@ void ASMLInitMod::LoadSchematics() {
 	for (TSubclassOf<UFGSchematic> schematic : mSchematics) {
 		TArray<TSubclassOf<UFGSchematic>> availableSchematics;
 		schematicManager->GetAvailableSchematics(availableSchematics);
-		SML::Logging::debug("Loading schematic ", *UFGSchematic::GetSchematicDisplayName(schematic).ToString(), " of mod ", *this->GetClass()->GetPathName());
+		SML_LOG_DEBUG(SML::Logging::LogSML, "Loading schematic ", *UFGSchematic::GetSchematicDisplayName(schematic).ToString(), " of mod ", *this->GetClass()->GetPathName());
 		if (!schematicManager->IsSchematicPurchased(schematic) && !availableSchematics.Contains(schematic)) {
-			SML::Logging::debug("Adding schematic ", *UFGSchematic::GetSchematicDisplayName(schematic).ToString(), " of mod ", *this->GetClass()->GetPathName());
+			SML_LOG_DEBUG(SML::Logging::LogSML, "Adding schematic ", *UFGSchematic::GetSchematicDisplayName(schematic).ToString(), " of mod ", *this->GetClass()->GetPathName());
 			schematicManager->AddAvailableSchematic(schematic);
 		}
 	}
@@ -8,6 +8,12 @@
 #include "Engine/UserDefinedStruct.h"
 #include "Engine/UserDefinedEnum.h"
 #include "Engine/MemberReference.h"
+#include "Async/Async.h"
+#include "Async/ParallelFor.h"
+#include "Misc/SecureHash.h"
+#include "Misc/PackageName.h"
+#include "HAL/FileManager.h"
+#include "util/JsonStreamReader.h"
 
 #define DEFAULT_ITERATOR_FLAGS EFieldIteratorFlags::IncludeSuper, EFieldIteratorFlags::IncludeDeprecated, EFieldIteratorFlags::IncludeInterfaces
 
@@ -257,7 +263,169 @@ TSharedRef<FJsonObject> dumpBlueprintContent(UBlueprintGeneratedClass* generated
 	return resultJson;
 }
 
-void SML::dumpSatisfactoryAssets(const FName& rootPath, const FString& fileName) {
+/**
+ * Writes dump as a single json document, appending every entry to the file as soon as it is ready
+ * Entries are written condensed, one per line, so readers can consume them one by one
+ */
+class FAssetDumpWriter {
+private:
+	TUniquePtr<FArchive> fileWriter;
+	bool hasSections = false;
+	bool sectionEmpty = true;
+public:
+	explicit FAssetDumpWriter(const FString& filePath) : fileWriter(IFileManager::Get().CreateFileWriter(*filePath)) {}
+
+	bool isValid() const {
+		return fileWriter.IsValid();
+	}
+
+	void beginSection(const TCHAR* sectionName) {
+		writeRaw(FString::Printf(TEXT("%s\"%s\": [\n"), hasSections ? TEXT("\n],\n") : TEXT("{\n"), sectionName));
+		hasSections = true;
+		sectionEmpty = true;
+	}
+
+	void writeEntry(const FString& entryJson) {
+		if (!sectionEmpty) {
+			writeRaw(TEXT(",\n"));
+		}
+		writeRaw(entryJson);
+		sectionEmpty = false;
+	}
+
+	/** Writes entry which is already serialized as UTF-8, e.g. one copied from the previous dump */
+	void writeEntry(const ANSICHAR* entryJson, int64 length) {
+		if (!sectionEmpty) {
+			writeRaw(TEXT(",\n"));
+		}
+		fileWriter->Serialize(const_cast<ANSICHAR*>(entryJson), length);
+		sectionEmpty = false;
+	}
+
+	void finish() {
+		writeRaw(hasSections ? TEXT("\n]\n}\n") : TEXT("{}\n"));
+		fileWriter->Close();
+	}
+private:
+	void writeRaw(const FString& string) {
+		FTCHARToUTF8 convertedString(*string);
+		fileWriter->Serialize(const_cast<ANSICHAR*>(convertedString.Get()), convertedString.Length());
+	}
+};
+
+FString serializeCondensed(const TSharedRef<FJsonObject>& jsonObject) {
+	FString resultString;
+	const TSharedRef<TJsonWriter<TCHAR, TCondensedJsonPrintPolicy<TCHAR>>> writer = TJsonWriterFactory<TCHAR, TCondensedJsonPrintPolicy<TCHAR>>::Create(&resultString);
+	FJsonSerializer::Serialize(jsonObject, writer);
+	return resultString;
+}
+
+/**
+ * Returns hash of the package file contents, including it's .uexp part if it exists
+ * Returns empty string if package file cannot be read
+ */
+FString computePackageHash(const FName& packageName) {
+	const FString packageFile = FPackageName::LongPackageNameToFilename(packageName.ToString());
+	const FMD5Hash assetHash = FMD5Hash::HashFile(*(packageFile + FPackageName::GetAssetPackageExtension()));
+	if (!assetHash.IsValid()) {
+		return TEXT("");
+	}
+	const FMD5Hash exportsHash = FMD5Hash::HashFile(*(packageFile + TEXT(".uexp")));
+	return LexToString(assetHash) + LexToString(exportsHash);
+}
+
+struct FPendingAssetDump {
+	UObject* assetObject;
+	TFuture<FString> entryJson;
+};
+
+/**
+ * Dumps given assets into the current writer section
+ * Loading happens on the game thread, while entries of already loaded objects are built and serialized
+ * on the thread pool. Loaded objects are rooted until their entry is written, and entries are written in asset order
+ */
+void dumpAssetsPipelined(const TArray<const FAssetData*>& assets, FAssetDumpWriter& writer, const TFunction<UObject*(const FAssetData&)>& loadAsset, const TFunction<TSharedRef<FJsonObject>(UObject*)>& dumpAsset) {
+	const int32 maxPendingDumps = FMath::Max(2, FPlatformMisc::NumberOfCoresIncludingHyperthreads());
+	TArray<FPendingAssetDump> pendingDumps;
+	const auto writeOldestDump = [&]() {
+		FPendingAssetDump& pendingDump = pendingDumps[0];
+		writer.writeEntry(pendingDump.entryJson.Get());
+		pendingDump.assetObject->RemoveFromRoot();
+		pendingDumps.RemoveAt(0, 1, false);
+	};
+	for (const FAssetData* assetData : assets) {
+		UObject* assetObject = loadAsset(*assetData);
+		if (assetObject == nullptr) {
+			continue;
+		}
+		assetObject->AddToRoot();
+		TFuture<FString> entryJson = Async<FString>(EAsyncExecution::ThreadPool, [assetObject, dumpAsset]() {
+			return serializeCondensed(dumpAsset(assetObject));
+		});
+		pendingDumps.Add(FPendingAssetDump{assetObject, MoveTemp(entryJson)});
+		while (pendingDumps.Num() >= maxPendingDumps || (pendingDumps.Num() > 0 && pendingDumps[0].entryJson.IsReady())) {
+			writeOldestDump();
+		}
+	}
+	while (pendingDumps.Num() > 0) {
+		writeOldestDump();
+	}
+}
+
+/**
+ * Entry of the dump written by the previous run, copied into the new dump as is if it's package is unchanged
+ */
+struct FPreviousDumpEntry {
+	FName packageName;
+	SML::JsonStream::FJsonValueSpan span;
+};
+
+//entries are identified by the path of the dumped object, StructName for enums and structs and Blueprint for classes
+bool readDumpEntryPackage(const SML::JsonStream::FMappedJsonFile& dumpFile, const SML::JsonStream::FJsonValueSpan& span, FName& outPackageName) {
+	using namespace SML::JsonStream;
+	FJsonPullParser parser(dumpFile.getData() + span.offset, span.length);
+	if (parser.next() != EJsonToken::BeginObject) {
+		return false;
+	}
+	while (parser.next() == EJsonToken::Key) {
+		const bool isObjectPath = parser.getString() == TEXT("StructName") || parser.getString() == TEXT("Blueprint");
+		if (parser.next() == EJsonToken::String && isObjectPath) {
+			outPackageName = FName(*FPackageName::ObjectPathToPackageName(parser.getString()));
+			return true;
+		}
+		if (!parser.skipValue()) {
+			return false;
+		}
+	}
+	return false;
+}
+
+/**
+ * Indexes entries of the previous dump by section, returns false if dump is malformed
+ */
+bool readPreviousDump(const SML::JsonStream::FMappedJsonFile& dumpFile, TMap<FString, TArray<FPreviousDumpEntry>>& outSections) {
+	using namespace SML::JsonStream;
+	FJsonPullParser parser = dumpFile.createParser();
+	if (parser.next() != EJsonToken::BeginObject) {
+		return false;
+	}
+	while (parser.next() == EJsonToken::Key) {
+		TArray<FPreviousDumpEntry>& entries = outSections.FindOrAdd(parser.getString());
+		if (parser.next() != EJsonToken::BeginArray) {
+			return false;
+		}
+		while (parser.next() != EJsonToken::EndArray) {
+			FPreviousDumpEntry entry;
+			if (!parser.skipValueSpan(entry.span) || !readDumpEntryPackage(dumpFile, entry.span, entry.packageName)) {
+				return false;
+			}
+			entries.Add(entry);
+		}
+	}
+	return parser.getToken() == EJsonToken::EndObject && parser.next() == EJsonToken::EndOfInput;
+}
+
+void SML::dumpSatisfactoryAssets(const FName& rootPath, const FString& fileName, bool incremental) {
 	SML::Logging::info(TEXT("Dumping assets on path "), *rootPath.ToString(), TEXT(" to json file "), *fileName);
 	FAssetRegistryModule& AssetRegistryModule = FModuleManager::LoadModuleChecked<FAssetRegistryModule>(FName("AssetRegistry"));
 	IAssetRegistry& AssetRegistry = AssetRegistryModule.Get();
@@ -265,49 +433,154 @@ void SML::dumpSatisfactoryAssets(const FName& rootPath, const FString& fileName)
 	AssetRegistry.GetAssetsByPath(rootPath, FoundAssets, true, false);
 	SML::Logging::info(*FString::Printf(TEXT("[FG Asset Dumper] FactoryGame total Assets to Dump: %d"), FoundAssets.Num()));
 
-	TArray<TSharedPtr<FJsonValue>> blueprints;
-	TArray<TSharedPtr<FJsonValue>> userDefinedStructs;
-	TArray<TSharedPtr<FJsonValue>> userDefinedEnums;
-	
+	TArray<const FAssetData*> userDefinedEnums;
+	TArray<const FAssetData*> userDefinedStructs;
+	TArray<const FAssetData*> blueprints;
+	TSet<FName> dumpedPackageSet;
 	for (const FAssetData& assetData : FoundAssets) {
 		const FString& assetClass = assetData.AssetClass.ToString();
 		if (assetClass == TEXT("UserDefinedStruct")) {
-			UObject* assetObject = assetData.GetAsset();
-			UUserDefinedStruct* definedStruct = Cast<UUserDefinedStruct>(assetObject);
-			if (definedStruct != nullptr) {
-				const TSharedRef<FJsonObject>& classJson = dumpUserDefinedStruct(definedStruct);
-				userDefinedStructs.Add(MakeShareable(new FJsonValueObject(classJson)));
+			userDefinedStructs.Add(&assetData);
+		} else if (assetClass == TEXT("UserDefinedEnum")) {
+			userDefinedEnums.Add(&assetData);
+		} else if (assetClass.Contains(TEXT("Blueprint"))) {
+			blueprints.Add(&assetData);
+		} else {
+			continue;
+		}
+		dumpedPackageSet.Add(assetData.PackageName);
+	}
+
+	//package hashes of dumped assets are always recorded, so the next dump can run incrementally
+	const FString& resultPath = SML::getConfigDirectory() / *fileName;
+	const FString hashesPath = resultPath + TEXT(".hashes.json");
+	const TArray<FName> dumpedPackages = dumpedPackageSet.Array();
+	TArray<FString> packageHashes;
+	packageHashes.SetNum(dumpedPackages.Num());
+	ParallelFor(dumpedPackages.Num(), [&](int32 i) {
+		packageHashes[i] = computePackageHash(dumpedPackages[i]);
+	});
+	TSharedRef<FJsonObject> currentHashes = MakeShareable(new FJsonObject());
+	for (int32 i = 0; i < dumpedPackages.Num(); i++) {
+		if (!packageHashes[i].IsEmpty()) {
+			currentHashes->SetStringField(dumpedPackages[i].ToString(), packageHashes[i]);
+		}
+	}
+
+	//in incremental mode entries of unchanged packages are copied from the previous dump, so result is always complete
+	TSharedPtr<FJsonObject> previousHashes;
+	TUniquePtr<SML::JsonStream::FMappedJsonFile> previousDump;
+	TMap<FString, TArray<FPreviousDumpEntry>> previousSections;
+	if (incremental) {
+		FString hashesString;
+		if (FFileHelper::LoadFileToString(hashesString, *hashesPath)) {
+			const TSharedRef<TJsonReader<>> reader = TJsonReaderFactory<>::Create(hashesString);
+			FJsonSerializer::Deserialize(reader, previousHashes);
+		}
+		previousDump = MakeUnique<SML::JsonStream::FMappedJsonFile>();
+		if (!previousHashes.IsValid()) {
+			SML::Logging::info(TEXT("[FG Asset Dumper] No previous package hashes found, dumping everything"));
+		} else if (!previousDump->open(resultPath) || !readPreviousDump(*previousDump, previousSections)) {
+			SML::Logging::info(TEXT("[FG Asset Dumper] Previous dump is missing or malformed, dumping everything"));
+			previousHashes.Reset();
+			previousSections.Empty();
+		}
+	}
+
+	TSet<FName> unchangedPackages;
+	if (previousHashes.IsValid()) {
+		//package is only reused if previous dump actually has it's entry, assets failed to load before are retried
+		TSet<FName> previousDumpPackages;
+		for (const auto& pair : previousSections) {
+			for (const FPreviousDumpEntry& entry : pair.Value) {
+				previousDumpPackages.Add(entry.packageName);
 			}
 		}
-		if (assetClass == TEXT("UserDefinedEnum")) {
-			UObject* assetObject = assetData.GetAsset();
-			UUserDefinedEnum* definedEnum = Cast<UUserDefinedEnum>(assetObject);
-			if (definedEnum != nullptr) {
-				const TSharedRef<FJsonObject>& classJson = dumpUserDefinedEnum(definedEnum);
-				userDefinedEnums.Add(MakeShareable(new FJsonValueObject(classJson)));
+		TArray<FName> changedPackages;
+		for (int32 i = 0; i < dumpedPackages.Num(); i++) {
+			FString previousHash;
+			if (!packageHashes[i].IsEmpty() && previousDumpPackages.Contains(dumpedPackages[i]) &&
+				previousHashes->TryGetStringField(dumpedPackages[i].ToString(), previousHash) && previousHash == packageHashes[i]) {
+				unchangedPackages.Add(dumpedPackages[i]);
+			} else {
+				changedPackages.Add(dumpedPackages[i]);
 			}
 		}
-		if (assetClass.Contains(TEXT("Blueprint"))) {
-			FString resultPath = assetData.ObjectPath.ToString().Append(TEXT("_C"));
-			UObject* assetObject = StaticLoadObject(UObject::StaticClass(), nullptr, *resultPath);
-			UBlueprintGeneratedClass* generatedClass = Cast<UBlueprintGeneratedClass>(assetObject);
-			if (generatedClass != nullptr) {
-				const TSharedRef<FJsonObject>& classJson = dumpBlueprintContent(generatedClass);
-				blueprints.Add(MakeShareable(new FJsonValueObject(classJson)));
+		//dumps of the packages referencing changed ones can change too, e.g. blueprints inheriting changed class or using changed struct
+		for (int32 i = 0; i < changedPackages.Num(); i++) {
+			TArray<FName> referencers;
+			AssetRegistry.GetReferencers(changedPackages[i], referencers);
+			for (const FName& referencer : referencers) {
+				if (unchangedPackages.Remove(referencer) > 0) {
+					changedPackages.Add(referencer);
+				}
 			}
 		}
+		const auto isUnchanged = [&unchangedPackages](const FAssetData* assetData) {
+			return unchangedPackages.Contains(assetData->PackageName);
+		};
+		userDefinedEnums.RemoveAll(isUnchanged);
+		userDefinedStructs.RemoveAll(isUnchanged);
+		blueprints.RemoveAll(isUnchanged);
+		SML::Logging::info(*FString::Printf(TEXT("[FG Asset Dumper] Reusing previous dump of %d unchanged packages, %d packages changed"), unchangedPackages.Num(), changedPackages.Num()));
 	}
-	TSharedRef<FJsonObject> resultObject = MakeShareable(new FJsonObject());
-	resultObject->SetArrayField(TEXT("UserDefinedEnums"), userDefinedEnums);
-	resultObject->SetArrayField(TEXT("UserDefinedStructs"), userDefinedStructs);
-	resultObject->SetArrayField(TEXT("Blueprints"), blueprints);
 
-	const FString& resultPath = SML::getConfigDirectory() / *fileName;
-	FString resultString;
-	TSharedRef<TJsonWriter<>> writer = TJsonWriterFactory<>::Create(&resultString);
-	FJsonSerializer Serializer;
-	Serializer.Serialize(resultObject, writer);
-	FFileHelper::SaveStringToFile(resultString, *resultPath, FFileHelper::EEncodingOptions::ForceUTF8);
+	//previous dump is still being read, so new one is written next to it and replaces it once complete
+	const FString tempResultPath = resultPath + TEXT(".tmp");
+	FAssetDumpWriter writer(tempResultPath);
+	if (!writer.isValid()) {
+		SML::Logging::error(TEXT("Failed to open dump file for writing: "), *tempResultPath);
+		return;
+	}
+	const auto beginSection = [&](const TCHAR* sectionName) {
+		writer.beginSection(sectionName);
+		const TArray<FPreviousDumpEntry>* previousEntries = previousSections.Find(sectionName);
+		if (previousEntries != nullptr) {
+			for (const FPreviousDumpEntry& entry : *previousEntries) {
+				if (unchangedPackages.Contains(entry.packageName)) {
+					writer.writeEntry(previousDump->getData() + entry.span.offset, entry.span.length);
+				}
+			}
+		}
+	};
+	beginSection(TEXT("UserDefinedEnums"));
+	dumpAssetsPipelined(userDefinedEnums, writer, [](const FAssetData& assetData) -> UObject* {
+		return Cast<UUserDefinedEnum>(assetData.GetAsset());
+	}, [](UObject* assetObject) {
+		return dumpUserDefinedEnum(static_cast<UUserDefinedEnum*>(assetObject));
+	});
+	beginSection(TEXT("UserDefinedStructs"));
+	dumpAssetsPipelined(userDefinedStructs, writer, [](const FAssetData& assetData) -> UObject* {
+		return Cast<UUserDefinedStruct>(assetData.GetAsset());
+	}, [](UObject* assetObject) {
+		return dumpUserDefinedStruct(static_cast<UUserDefinedStruct*>(assetObject));
+	});
+	beginSection(TEXT("Blueprints"));
+	dumpAssetsPipelined(blueprints, writer, [](const FAssetData& assetData) -> UObject* {
+		FString resultPath = assetData.ObjectPath.ToString().Append(TEXT("_C"));
+		UObject* assetObject = StaticLoadObject(UObject::StaticClass(), nullptr, *resultPath);
+		UBlueprintGeneratedClass* generatedClass = Cast<UBlueprintGeneratedClass>(assetObject);
+		if (generatedClass != nullptr) {
+			//default objects can only be created on the game thread, so make sure they exist before dumping
+			generatedClass->GetDefaultObject();
+			generatedClass->GetSuperClass()->GetDefaultObject();
+		}
+		return generatedClass;
+	}, [](UObject* assetObject) {
+		return dumpBlueprintContent(static_cast<UBlueprintGeneratedClass*>(assetObject));
+	});
+	writer.finish();
+	//mapped previous dump has to be closed before it can be replaced
+	previousDump.Reset();
+	if (!IFileManager::Get().Move(*resultPath, *tempResultPath, true)) {
+		SML::Logging::error(TEXT("Failed to replace dump file "), *resultPath);
+		return;
+	}
+
+	FString hashesString;
+	const TSharedRef<TJsonWriter<>> hashesWriter = TJsonWriterFactory<>::Create(&hashesString);
+	FJsonSerializer::Serialize(currentHashes, hashesWriter);
+	FFileHelper::SaveStringToFile(hashesString, *hashesPath, FFileHelper::EEncodingOptions::ForceUTF8);
 	SML::Logging::info(TEXT("Dumping finished!"));
 }
 
@@ -7,9 +7,14 @@ namespace SML {
 	 * and it's subdirectories, and writes it as the json into the specified file
 	 * While it is primarily used to dump satisfactory blueprint assets,
 	 * it can take any root path and dump any pak content's, including SML, mods and engine itself
+	 * Entries are written to the file as soon as they are dumped, one per line
+	 *
+	 * Package hashes of dumped assets are saved next to the file. In incremental mode only assets with packages
+	 * changed since the previous dump, and assets referencing them, are dumped again. Entries of other assets
+	 * are copied from the previous dump, so the resulting file is always a complete dump
 	 *
 	 * Example Usage:
 	 * SML::dumpSatisfactoryAssets(TEXT("/Game/FactoryGame/"), TEXT("FGBlueprints.json"));
 	 */
-	void dumpSatisfactoryAssets(const FName& rootPath, const FString& fileName);
+	void dumpSatisfactoryAssets(const FName& rootPath, const FString& fileName, bool incremental = false);
 }
\ No newline at end of file
@@ -18,12 +18,16 @@
 #include "K2Node_FunctionResult.h"
 #include "K2Node_CallFunction.h"
 #include "util/Logging.h"
+#include "Async/ParallelFor.h"
+#include "util/JsonStreamReader.h"
 
 struct FPackageObjectData {
 	FString ObjectPath;
 	TSharedPtr<FJsonObject> SourceObject;
 	bool bIsUserStruct;
 	bool bIsBlueprint;
+	//location of the source object in the dump, it is parsed again right before object creation
+	SML::JsonStream::FJsonValueSpan SourceSpan;
 };
 
 struct FStructInitData {
@@ -45,15 +49,16 @@ FPackageObjectData OBJECT_DATA_Empty;
 
 void ParseObjectPath(const FString& ObjectPath, FString& PackageName, FString& ObjectName);
 FEdGraphPinType CreateGraphPinType(const TSharedRef<FJsonObject>& PinJson);
-void GatherPinTypeDependencies(const TSharedRef<FJsonObject>& PinJson, TArray<FString>& Dependencies);
+void GatherPinTypeDependencies(const TSharedRef<FJsonObject>& PinJson, TArray<FString>& Dependencies, TArray<FString>& PinObjectPaths);
+UObject* ResolvePinObject(const FString& ObjectPath);
 bool IsObjectAlreadyLoaded(const FString& ObjectPath);
 void AddDependencyIfNeeded(const FString& ObjectPath, TArray<FString>& Dependencies);
 
-FPackageObjectData CreateStructHeader(const TSharedRef<FJsonObject>& StructJson, TArray<FString>& Dependencies);
-FPackageObjectData CreateBlueprintHeader(const TSharedRef<FJsonObject>& StructJson, TArray<FString>& Dependencies);
+FPackageObjectData CreateStructHeader(const TSharedRef<FJsonObject>& StructJson, TArray<FString>& Dependencies, TArray<FString>& PinObjectPaths);
+FPackageObjectData CreateBlueprintHeader(const TSharedRef<FJsonObject>& StructJson, TArray<FString>& Dependencies, TArray<FString>& PinObjectPaths);
 
 UPackage* CreateEnumerationFromJson(const TSharedRef<FJsonObject>& EnumJson);
-FObjectInfo CreateGenericObject(const FPackageObjectData& PackageObjectData, bool bHasDependents);
+FObjectInfo CreateGenericObject(const SML::JsonStream::FMappedJsonFile& DumpFile, const FPackageObjectData& PackageObjectData, bool bHasDependents);
 FObjectInfo CreateStructFromJson(const TSharedRef<FJsonObject>& StructJson, bool bHasDependents);
 FObjectInfo CreateBlueprintFromJson(const TSharedRef<FJsonObject>& BlueprintJson, bool bHasDependents);
 
@@ -80,33 +85,121 @@ inline uint64 AddPackageDependencies(const FString& ObjectPath, const TArray<FSt
 	return ObjectIndex;
 }
 
-void SML::generateSatisfactoryAssets(const FString& DataJsonFilePath) {
-	FString LoadedJsonFileText;
+struct FObjectHeaderEntry {
+	FPackageObjectData ObjectData;
+	TArray<FString> Dependencies;
+	//paths of all objects referenced by pin types of this object, including already loaded ones
+	TArray<FString> PinObjectPaths;
+};
+
+/**
+ * Creates headers for all struct or blueprint json objects at the given spans of the dump
+ * Every object is parsed by a single worker and released right after it's header is created,
+ * so only headers are kept in memory until objects are actually created
+ */
+void CreateObjectHeaders(const SML::JsonStream::FMappedJsonFile& DumpFile, const TArray<SML::JsonStream::FJsonValueSpan>& Spans, bool bIsBlueprint, bool bConcurrent, TArray<FObjectHeaderEntry>& OutHeaders) {
+	OutHeaders.SetNum(Spans.Num());
+	ParallelFor(Spans.Num(), [&](int32 i) {
+		FObjectHeaderEntry& HeaderEntry = OutHeaders[i];
+		const TSharedPtr<FJsonObject> ObjectJson = DumpFile.readObjectAt(Spans[i]);
+		check(ObjectJson.IsValid());
+		HeaderEntry.ObjectData = bIsBlueprint ?
+			CreateBlueprintHeader(ObjectJson.ToSharedRef(), HeaderEntry.Dependencies, HeaderEntry.PinObjectPaths) :
+			CreateStructHeader(ObjectJson.ToSharedRef(), HeaderEntry.Dependencies, HeaderEntry.PinObjectPaths);
+		HeaderEntry.ObjectData.SourceObject.Reset();
+		HeaderEntry.ObjectData.SourceSpan = Spans[i];
+	}, !bConcurrent);
+}
+
+/**
+ * Records spans of all elements of the top level arrays of the dump, without building the object model
+ * Returns false if dump is malformed
+ */
+bool IndexDumpSections(const SML::JsonStream::FMappedJsonFile& DumpFile, TMap<FString, TArray<SML::JsonStream::FJsonValueSpan>>& OutSections, FString& OutErrorMessage) {
+	using namespace SML::JsonStream;
+	FJsonPullParser Parser = DumpFile.createParser();
+	if (Parser.next() != EJsonToken::BeginObject) {
+		OutErrorMessage = TEXT("Dump root is not an object");
+		return false;
+	}
+	while (Parser.next() == EJsonToken::Key) {
+		TArray<FJsonValueSpan>& SectionSpans = OutSections.FindOrAdd(Parser.getString());
+		if (Parser.next() != EJsonToken::BeginArray) {
+			if (!Parser.skipValue()) {
+				break;
+			}
+			continue;
+		}
+		while (Parser.next() != EJsonToken::EndArray) {
+			FJsonValueSpan ElementSpan;
+			if (!Parser.skipValueSpan(ElementSpan)) {
+				break;
+			}
+			SectionSpans.Add(ElementSpan);
+		}
+	}
+	if (Parser.getToken() != EJsonToken::EndObject || Parser.next() != EJsonToken::EndOfInput) {
+		OutErrorMessage = Parser.getErrorMessage();
+		return false;
+	}
+	return true;
+}
+
+/** Records time spent in the generation phases, so they can be logged together once generation is done */
+class FGeneratorPhaseTimings {
+	TArray<TPair<FString, double>> Phases;
+	double PhaseStartTime = FPlatformTime::Seconds();
+public:
+	void EndPhase(const TCHAR* PhaseName) {
+		const double CurrentTime = FPlatformTime::Seconds();
+		Phases.Add(TPair<FString, double>(PhaseName, CurrentTime - PhaseStartTime));
+		PhaseStartTime = CurrentTime;
+	}
+
+	void LogTimings() const {
+		double TotalTime = 0.0;
+		for (const TPair<FString, double>& Phase : Phases) {
+			SML::Logging::info(*FString::Printf(TEXT("[FG Asset Generator] %s: %.2fs"), *Phase.Key, Phase.Value));
+			TotalTime += Phase.Value;
+		}
+		SML::Logging::info(*FString::Printf(TEXT("[FG Asset Generator] Total: %.2fs"), TotalTime));
+	}
+};
+
+//objects resolved for pin types during current generation, to avoid looking up the same types over and over
+TMap<FString, UObject*> ResolvedPinObjects;
+
+void SML::generateSatisfactoryAssets(const FString& DataJsonFilePath, bool bBatchByLevel) {
+	FGeneratorPhaseTimings PhaseTimings;
+	ResolvedPinObjects.Empty();
 	SML::Logging::info(TEXT("Generating assets from dump "), *DataJsonFilePath);
-	const bool result = FFileHelper::LoadFileToString(LoadedJsonFileText, *DataJsonFilePath);
-	if (!result) {
+	//dump is mapped into memory and only indexed here, objects are parsed one by one when they are needed
+	SML::JsonStream::FMappedJsonFile DumpFile;
+	if (!DumpFile.open(DataJsonFilePath)) {
 		UE_LOG(LogTemp, Error, TEXT("Failed to load FG Blueprints definitions json file"));
 		return;
 	}
-	const TSharedRef<TJsonReader<>> Reader = TJsonReaderFactory<>::Create(LoadedJsonFileText);
-	FJsonSerializer Serializer;
-	TSharedPtr<FJsonObject> ResultJsonObject;
-	if (!Serializer.Deserialize(Reader, ResultJsonObject)) {
-		UE_LOG(LogTemp, Error, TEXT("Failed to parse FG Blueprints definitions json file"));
+	TMap<FString, TArray<SML::JsonStream::FJsonValueSpan>> DumpSections;
+	FString ParseErrorMessage;
+	if (!IndexDumpSections(DumpFile, DumpSections, ParseErrorMessage)) {
+		UE_LOG(LogTemp, Error, TEXT("Failed to parse FG Blueprints definitions json file: %s"), *ParseErrorMessage);
 		return;
 	}
+	PhaseTimings.EndPhase(TEXT("Indexing dump"));
 	SML::Logging::info(TEXT("Generating user defined enumerations..."));
 	TArray<UPackage*> DefinedPackages;
-	const TArray<TSharedPtr<FJsonValue>>& UserDefinedEnums = ResultJsonObject->GetArrayField(TEXT("UserDefinedEnums"));
-	for (const TSharedPtr<FJsonValue>& Value : UserDefinedEnums) {
-		UPackage* Package = CreateEnumerationFromJson(Value->AsObject().ToSharedRef());
+	for (const SML::JsonStream::FJsonValueSpan& EnumSpan : DumpSections.FindOrAdd(TEXT("UserDefinedEnums"))) {
+		const TSharedPtr<FJsonObject> EnumJson = DumpFile.readObjectAt(EnumSpan);
+		check(EnumJson.IsValid());
+		UPackage* Package = CreateEnumerationFromJson(EnumJson.ToSharedRef());
 		if (Package != nullptr) {
 			DefinedPackages.Add(Package);
 		}
 	}
+	PhaseTimings.EndPhase(TEXT("Generating enumerations"));
 	
-	const TArray<TSharedPtr<FJsonValue>>& UserDefinedStructs = ResultJsonObject->GetArrayField(TEXT("UserDefinedStructs"));
-	const TArray<TSharedPtr<FJsonValue>>& Blueprints = ResultJsonObject->GetArrayField(TEXT("Blueprints"));
+	const TArray<SML::JsonStream::FJsonValueSpan> UserDefinedStructs = MoveTemp(DumpSections.FindOrAdd(TEXT("UserDefinedStructs")));
+	const TArray<SML::JsonStream::FJsonValueSpan> Blueprints = MoveTemp(DumpSections.FindOrAdd(TEXT("Blueprints")));
 
 	SML::TopologicalSort::DirectedGraph<uint64> DependencyGraph;
 	TMap<uint64, FPackageObjectData> ObjectHeaders;
@@ -116,40 +209,73 @@ void SML::generateSatisfactoryAssets(const FString& DataJsonFilePath) {
 
 	SML::Logging::info(TEXT("Building structure dependency graph..."));
 	//Gather UserStruct and Blueprint dependencies now
-	for (const TSharedPtr<FJsonValue>& Value : UserDefinedStructs) {
-		TArray<FString> Dependencies;
-		const FPackageObjectData& ObjectData = CreateStructHeader(Value->AsObject().ToSharedRef(), Dependencies);
-		if (!ObjectData.ObjectPath.IsEmpty()) {
-			uint64 ObjectIndex = AddPackageDependencies(ObjectData.ObjectPath, Dependencies, DependencyGraph, LastObjectIndex, ObjectPathToIndex, HasDependentsMap);
-			ObjectHeaders.Add(ObjectIndex, ObjectData);
-		}
-	}
+	TArray<FObjectHeaderEntry> StructHeaders;
+	CreateObjectHeaders(DumpFile, UserDefinedStructs, false, bBatchByLevel, StructHeaders);
 	SML::Logging::info(TEXT("Building blueprint dependency graph..."));
-	for (const TSharedPtr<FJsonValue>& Value : Blueprints) {
-		TArray<FString> Dependencies;
-		const FPackageObjectData& ObjectData = CreateBlueprintHeader(Value->AsObject().ToSharedRef(), Dependencies);
-		if (!ObjectData.ObjectPath.IsEmpty()) {
-			uint64 ObjectIndex = AddPackageDependencies(ObjectData.ObjectPath, Dependencies, DependencyGraph, LastObjectIndex, ObjectPathToIndex, HasDependentsMap);
-			ObjectHeaders.Add(ObjectIndex, ObjectData);
+	TArray<FObjectHeaderEntry> BlueprintHeaders;
+	CreateObjectHeaders(DumpFile, Blueprints, true, bBatchByLevel, BlueprintHeaders);
+
+	TMap<uint64, TArray<FString>> ObjectPinPaths;
+	for (TArray<FObjectHeaderEntry>* Headers : {&StructHeaders, &BlueprintHeaders}) {
+		for (FObjectHeaderEntry& HeaderEntry : *Headers) {
+			const FPackageObjectData& ObjectData = HeaderEntry.ObjectData;
+			if (!ObjectData.ObjectPath.IsEmpty()) {
+				uint64 ObjectIndex = AddPackageDependencies(ObjectData.ObjectPath, HeaderEntry.Dependencies, DependencyGraph, LastObjectIndex, ObjectPathToIndex, HasDependentsMap);
+				ObjectHeaders.Add(ObjectIndex, ObjectData);
+				ObjectPinPaths.Add(ObjectIndex, MoveTemp(HeaderEntry.PinObjectPaths));
+			}
 		}
 	}
+	StructHeaders.Empty();
+	BlueprintHeaders.Empty();
+	PhaseTimings.EndPhase(TEXT("Building dependency graph"));
 
 	//Apply topological sort now
 	try {
-		const auto& SortingResult = SML::TopologicalSort::topologicalSort(DependencyGraph);
+		TArray<uint64> SortingResult;
 		TMap<uint64, FObjectInfo> ObjectInfoMap;
-		SML::Logging::info(TEXT("Loading assets..."));
-		//Load assets in sorted order now
-		for (uint64 ObjectIndex : SortingResult) {
-			const FPackageObjectData& ObjectData = ObjectHeaders[ObjectIndex];
-			check(!ObjectData.ObjectPath.IsEmpty());
-			bool bHasDependents = HasDependentsMap.Contains(ObjectIndex);
-			const FObjectInfo& CreatedObject = CreateGenericObject(ObjectData, bHasDependents);
-			check(CreatedObject.LoadedObject != nullptr);
-			ObjectInfoMap.Add(ObjectIndex, CreatedObject);
+		if (bBatchByLevel) {
+			const TArray<TArray<uint64>>& SortingLevels = SML::TopologicalSort::topologicalLevels(DependencyGraph);
+			SML::Logging::info(*FString::Printf(TEXT("Loading assets in %d levels..."), SortingLevels.Num()));
+			for (const TArray<uint64>& Level : SortingLevels) {
+				//objects of previous levels are created and compiled at that point,
+				//so pin type objects of the whole level can be resolved upfront
+				TSet<FString> LevelPinPaths;
+				for (uint64 ObjectIndex : Level) {
+					LevelPinPaths.Append(ObjectPinPaths[ObjectIndex]);
+				}
+				for (const FString& PinObjectPath : LevelPinPaths) {
+					UObject* PinObject = ResolvePinObject(PinObjectPath);
+					check(PinObject != nullptr);
+				}
+				//objects of the same level do not depend on each other, so blueprints can be
+				//queued and compiled together once the whole level is created
+				for (uint64 ObjectIndex : Level) {
+					const FPackageObjectData& ObjectData = ObjectHeaders[ObjectIndex];
+					check(!ObjectData.ObjectPath.IsEmpty());
+					const FObjectInfo& CreatedObject = CreateGenericObject(DumpFile, ObjectData, false);
+					check(CreatedObject.LoadedObject != nullptr);
+					ObjectInfoMap.Add(ObjectIndex, CreatedObject);
+					SortingResult.Add(ObjectIndex);
+				}
+				FBlueprintCompilationManager::FlushCompilationQueueAndReinstance();
+			}
+		} else {
+			SortingResult = SML::TopologicalSort::topologicalSort(DependencyGraph);
+			SML::Logging::info(TEXT("Loading assets..."));
+			//Load assets in sorted order now
+			for (uint64 ObjectIndex : SortingResult) {
+				const FPackageObjectData& ObjectData = ObjectHeaders[ObjectIndex];
+				check(!ObjectData.ObjectPath.IsEmpty());
+				bool bHasDependents = HasDependentsMap.Contains(ObjectIndex);
+				const FObjectInfo& CreatedObject = CreateGenericObject(DumpFile, ObjectData, bHasDependents);
+				check(CreatedObject.LoadedObject != nullptr);
+				ObjectInfoMap.Add(ObjectIndex, CreatedObject);
+			}
+			//Compile queued blueprints without dependents now
+			FBlueprintCompilationManager::FlushCompilationQueueAndReinstance();
 		}
-		//Compile queued blueprints without dependents now
-		FBlueprintCompilationManager::FlushCompilationQueueAndReinstance();
+		PhaseTimings.EndPhase(TEXT("Creating and compiling assets"));
 
 		SML::Logging::info(TEXT("Post-initializing loaded assets.."));
 		//Now, post initialize delayed default properties
@@ -158,19 +284,28 @@ void SML::generateSatisfactoryAssets(const FString& DataJsonFilePath) {
 			PostInitializeObject(ObjectInfo);
 			DefinedPackages.Add(ObjectInfo.ObjectPackage);
 		}
+		PhaseTimings.EndPhase(TEXT("Post-initializing assets"));
 		
 	} catch (const SML::TopologicalSort::cycle_detected<uint64>& ex) {
-		const FString& CyclePath = ObjectHeaders[ex.cycleNode].ObjectPath;
-		UE_LOG(LogTemp, Fatal, TEXT("Cycle detected in FG asset dependency graph at asset: "), *CyclePath);
+		TArray<FString> CycleObjectPaths;
+		for (uint64 ObjectIndex : ex.cyclePath) {
+			CycleObjectPaths.Add(ObjectHeaders[ObjectIndex].ObjectPath);
+		}
+		CycleObjectPaths.Add(ObjectHeaders[ex.cycleNode].ObjectPath);
+		const FString CyclePath = FString::Join(CycleObjectPaths, TEXT(" -> "));
+		UE_LOG(LogTemp, Fatal, TEXT("Cycle detected in FG asset dependency graph: %s"), *CyclePath);
 	}
 
 	SML::Logging::info(TEXT("Saving Packages..."));
 	//Now, prompt user to save all packages we defined
 	UEditorLoadingAndSavingUtils::SavePackages(DefinedPackages, false);
+	PhaseTimings.EndPhase(TEXT("Saving packages"));
+	ResolvedPinObjects.Empty();
 	SML::Logging::info(TEXT("Success!"));
+	PhaseTimings.LogTimings();
 }
 
-FPackageObjectData CreateBlueprintHeader(const TSharedRef<FJsonObject>& StructJson, TArray<FString>& Dependencies) {
+FPackageObjectData CreateBlueprintHeader(const TSharedRef<FJsonObject>& StructJson, TArray<FString>& Dependencies, TArray<FString>& PinObjectPaths) {
 	const FString& ObjectPath = StructJson->GetStringField(TEXT("Blueprint"));
 	if (IsObjectAlreadyLoaded(ObjectPath)) {
 		return OBJECT_DATA_Empty;
@@ -194,7 +329,7 @@ FPackageObjectData CreateBlueprintHeader(const TSharedRef<FJsonObject>& StructJs
 		for (const TSharedPtr<FJsonValue>& Value : Fields) {
 			const FJsonObject* ValueObject = Value.Get()->AsObject().Get();
 			TSharedPtr<FJsonObject> PinData = ValueObject->GetObjectField(TEXT("PinType"));
-			GatherPinTypeDependencies(PinData.ToSharedRef(), Dependencies);
+			GatherPinTypeDependencies(PinData.ToSharedRef(), Dependencies, PinObjectPaths);
 		}
 	}
 	//check function return types and arguments
@@ -204,13 +339,13 @@ FPackageObjectData CreateBlueprintHeader(const TSharedRef<FJsonObject>& StructJs
 			const FJsonObject* ValueObject = Value.Get()->AsObject().Get();
 			if (ValueObject->HasField(TEXT("ReturnType"))) {
 				const TSharedPtr<FJsonObject>& PinType = ValueObject->GetObjectField(TEXT("ReturnType"))->GetObjectField(TEXT("PinType"));
-				GatherPinTypeDependencies(PinType.ToSharedRef(), Dependencies);
+				GatherPinTypeDependencies(PinType.ToSharedRef(), Dependencies, PinObjectPaths);
 			}
 			if (ValueObject->HasField(TEXT("Arguments"))) {
 				const TArray<TSharedPtr<FJsonValue>>& Arguments = ValueObject->GetArrayField(TEXT("Arguments"));
 				for (const TSharedPtr<FJsonValue> ArgumentValue : Arguments) {
 					const TSharedPtr<FJsonObject>& PinType = ArgumentValue->AsObject()->GetObjectField(TEXT("PinType"));
-					GatherPinTypeDependencies(PinType.ToSharedRef(), Dependencies);
+					GatherPinTypeDependencies(PinType.ToSharedRef(), Dependencies, PinObjectPaths);
 				}
 			}
 		}
@@ -255,7 +390,7 @@ void PostInitializeObject(const FObjectInfo& ObjectInfo) {
 }
 
 
-FPackageObjectData CreateStructHeader(const TSharedRef<FJsonObject>& StructJson, TArray<FString>& Dependencies) {
+FPackageObjectData CreateStructHeader(const TSharedRef<FJsonObject>& StructJson, TArray<FString>& Dependencies, TArray<FString>& PinObjectPaths) {
 	const FString& ObjectPath = StructJson->GetStringField(TEXT("StructName"));
 	if (IsObjectAlreadyLoaded(ObjectPath)) {
 		return OBJECT_DATA_Empty;
@@ -264,7 +399,7 @@ FPackageObjectData CreateStructHeader(const TSharedRef<FJsonObject>& StructJson,
 	for (const TSharedPtr<FJsonValue>& Value : Fields) {
 		const FJsonObject* ValueObject = Value.Get()->AsObject().Get();
 		TSharedPtr<FJsonObject> PinData = ValueObject->GetObjectField(TEXT("PinType"));
-		GatherPinTypeDependencies(PinData.ToSharedRef(), Dependencies);
+		GatherPinTypeDependencies(PinData.ToSharedRef(), Dependencies, PinObjectPaths);
 	}
 	return FPackageObjectData{ ObjectPath, StructJson, true, false };
 }
@@ -308,12 +443,14 @@ FGuid AddStructVariableWithName(UUserDefinedStruct* Struct, const FEdGraphPinTyp
 	return Guid;
 }
 
-FObjectInfo CreateGenericObject(const FPackageObjectData& PackageObjectData, bool bHasDependents) {
+FObjectInfo CreateGenericObject(const SML::JsonStream::FMappedJsonFile& DumpFile, const FPackageObjectData& PackageObjectData, bool bHasDependents) {
+	const TSharedPtr<FJsonObject> SourceObject = DumpFile.readObjectAt(PackageObjectData.SourceSpan);
+	check(SourceObject.IsValid());
 	if (PackageObjectData.bIsUserStruct) {
-		return CreateStructFromJson(PackageObjectData.SourceObject.ToSharedRef(), bHasDependents);
+		return CreateStructFromJson(SourceObject.ToSharedRef(), bHasDependents);
 	}
 	if (PackageObjectData.bIsBlueprint) {
-		return CreateBlueprintFromJson(PackageObjectData.SourceObject.ToSharedRef(), bHasDependents);
+		return CreateBlueprintFromJson(SourceObject.ToSharedRef(), bHasDependents);
 	}
 	return FObjectInfo{ nullptr };
 }
@@ -544,16 +681,18 @@ void ParseObjectPath(const FString& ObjectPath, FString& PackageName, FString& O
 	PackageName = ObjectPath.Mid(0, LastDotIndex);
 }
 
-void GatherPinTypeDependencies(const TSharedRef<FJsonObject>& PinJson, TArray<FString>& Dependencies) {
+void GatherPinTypeDependencies(const TSharedRef<FJsonObject>& PinJson, TArray<FString>& Dependencies, TArray<FString>& PinObjectPaths) {
 	if (PinJson->HasField(TEXT("PinSubCategoryObject"))) {
 		const FString& ObjectPath = PinJson->GetStringField(TEXT("PinSubCategoryObject"));
 		AddDependencyIfNeeded(ObjectPath, Dependencies);
+		PinObjectPaths.Add(ObjectPath);
 	}
 	if (PinJson->HasField(TEXT("PinSubCategoryMemberReference"))) {
 		const TSharedPtr<FJsonObject>& MemberJson = PinJson->GetObjectField(TEXT("PinSubCategoryMemberReference"));
 		if (MemberJson->HasField("MemberParent")) {
 			const FString& ObjectPath = MemberJson->GetStringField(TEXT("MemberParent"));
 			AddDependencyIfNeeded(ObjectPath, Dependencies);
+			PinObjectPaths.Add(ObjectPath);
 		}
 	}
 	if (PinJson->HasField(TEXT("PinValueType"))) {
@@ -561,6 +700,7 @@ void GatherPinTypeDependencies(const TSharedRef<FJsonObject>& PinJson, TArray<FS
 		if (ValueJson->HasField(TEXT("TerminalSubCategoryObject"))) {
 			const FString& ObjectPath = ValueJson->GetStringField(TEXT("TerminalSubCategoryObject"));
 			AddDependencyIfNeeded(ObjectPath, Dependencies);
+			PinObjectPaths.Add(ObjectPath);
 		}
 	}
 }
@@ -571,7 +711,7 @@ FEdGraphPinType CreateGraphPinType(const TSharedRef<FJsonObject>& PinJson) {
 	GraphPinType.PinSubCategory = *PinJson->GetStringField(TEXT("PinSubCategory"));
 	if (PinJson->HasField(TEXT("PinSubCategoryObject"))) {
 		const FString& ObjectPath = PinJson->GetStringField(TEXT("PinSubCategoryObject"));
-		UObject* PinSubCategoryObject = LoadObject<UObject>(GetTransientPackage(), *ObjectPath);
+		UObject* PinSubCategoryObject = ResolvePinObject(ObjectPath);
 		check(PinSubCategoryObject != nullptr);
 		GraphPinType.PinSubCategoryObject = PinSubCategoryObject;
 	}
@@ -580,7 +720,7 @@ FEdGraphPinType CreateGraphPinType(const TSharedRef<FJsonObject>& PinJson) {
 		const TSharedPtr<FJsonObject>& MemberJson = PinJson->GetObjectField(TEXT("PinSubCategoryMemberReference"));
 		if (MemberJson->HasField("MemberParent")) {
 			const FString& ObjectPath = MemberJson->GetStringField(TEXT("MemberParent"));
-			UObject* MemberParentObject = LoadObject<UObject>(GetTransientPackage(), *ObjectPath);
+			UObject* MemberParentObject = ResolvePinObject(ObjectPath);
 			check(MemberParentObject != nullptr);
 			MemberRef.MemberParent = MemberParentObject;
 		}
@@ -595,7 +735,7 @@ FEdGraphPinType CreateGraphPinType(const TSharedRef<FJsonObject>& PinJson) {
 		ValueType.TerminalSubCategory = *ValueJson->GetStringField(TEXT("TerminalSubCategory"));
 		if (ValueJson->HasField(TEXT("TerminalSubCategoryObject"))) {
 			const FString& ObjectPath = ValueJson->GetStringField(TEXT("TerminalSubCategoryObject"));
-			UObject* TerminalSubCategoryObject = LoadObject<UObject>(GetTransientPackage(), *ObjectPath);
+			UObject* TerminalSubCategoryObject = ResolvePinObject(ObjectPath);
 			check(TerminalSubCategoryObject != nullptr);
 			ValueType.TerminalSubCategoryObject = TerminalSubCategoryObject;
 		}
@@ -618,6 +758,19 @@ FEdGraphPinType CreateGraphPinType(const TSharedRef<FJsonObject>& PinJson) {
 	return GraphPinType;
 }
 
+UObject* ResolvePinObject(const FString& ObjectPath) {
+	UObject** ResolvedObject = ResolvedPinObjects.Find(ObjectPath);
+	if (ResolvedObject != nullptr) {
+		return *ResolvedObject;
+	}
+	UObject* LoadedObject = LoadObject<UObject>(GetTransientPackage(), *ObjectPath);
+	//do not cache failed lookups, object can still be created later
+	if (LoadedObject != nullptr) {
+		ResolvedPinObjects.Add(ObjectPath, LoadedObject);
+	}
+	return LoadedObject;
+}
+
 bool IsObjectAlreadyLoaded(const FString& ObjectPath) {
 	return IsValid(FindObject<UObject>(GetTransientPackage(), *ObjectPath));
 }
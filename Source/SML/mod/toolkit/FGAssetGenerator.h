@@ -8,9 +8,13 @@ namespace SML {
 	 * WARNING! It takes some time, happens in multiple phases and is prone to multiple errors
 	 * Only call if you know what you're doing
 	 *
+	 * When bBatchByLevel is set, objects are grouped into dependency levels: headers are prepared concurrently,
+	 * pin type objects are resolved once per level and blueprints of every level are compiled in a single batch
+	 * Timings of every generation phase are logged once generation is done
+	 *
 	 * Example Usage:
 	 * SML::generateSatisfactoryAssets(TEXT("D:/SatisfactoryExperimental/configs/FGDataAssets.json"));
 	 */
-	void generateSatisfactoryAssets(const FString& DataJsonFilePath);
+	void generateSatisfactoryAssets(const FString& DataJsonFilePath, bool bBatchByLevel = false);
 }
 #endif
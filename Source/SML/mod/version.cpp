@@ -1,27 +1,10 @@
 #pragma once
 #include "version.h"
-#include <regex>
 #include "util/Utility.h"
 #include "util/Logging.h"
 
 using namespace SML::Versioning;
 
-std::wregex versionRegex(TEXT("^(<=|<|>|>=|\\^)?(0|[1-9]\\d*)\\.(0|[1-9]\\d*)\\.(0|[1-9]\\d*)(?:-((?:0|[1-9]\\d*|\\d*[a-zA-Z-][0-9a-zA-Z-]*)(?:\\.(?:0|[1-9]\\d*|\\d*[a-zA-Z-][0-9a-zA-Z-]*))*))?(?:\\+([0-9a-zA-Z-]+(?:\\.[0-9a-zA-Z-]+)*))?$"), std::regex::ECMAScript | std::regex::optimize);
-
-void parseVersion(const FString& string, FVersion& version, FString* compareOp);
-
-EComparisonOp parseComparisonOp(const FString& type) {
-	if (type == TEXT("<="))
-		return EComparisonOp::LESS_EQUALS;
-	if (type == TEXT("<"))
-		return EComparisonOp::LESS;
-	if (type == TEXT(">="))
-		return EComparisonOp::GREATER_EQUALS;
-	if (type == TEXT(">"))
-		return EComparisonOp::GREATER;
-	return EComparisonOp::EQUALS;
-}
-
 const TCHAR* comparisonString(const EComparisonOp op) {
 	switch (op) {
 	case EComparisonOp::EQUALS: return TEXT("");
@@ -33,12 +16,30 @@ const TCHAR* comparisonString(const EComparisonOp op) {
 	}	
 }
 
-FVersion::FVersion() {}
+bool SML::Versioning::parseVersion(const TCHAR* string, int32 length, FVersion& outVersion, EComparisonOp* outCompareOp) {
+	Parser::FParsedVersion parsed;
+	if (!Parser::parseVersion(string, length, parsed) || (outCompareOp == nullptr && parsed.opLength > 0)) {
+		outVersion = FVersion();
+		return false;
+	}
+	if (outCompareOp != nullptr) {
+		*outCompareOp = parsed.op;
+	}
+	outVersion.major = parsed.major;
+	outVersion.minor = parsed.minor;
+	outVersion.patch = parsed.patch;
+	outVersion.type = FString(parsed.typeLength, string + parsed.typeStart);
+	outVersion.buildInfo = FString(parsed.buildInfoLength, string + parsed.buildInfoStart);
+	return true;
+}
+
+FVersion::FVersion() : major(0), minor(0), patch(0) {}
 
 FVersion::FVersion(const FString& string) {
-	FString compareOp;
-	parseVersion(string, *this, &compareOp);
-	if (!compareOp.IsEmpty()) {
+	EComparisonOp compareOp;
+	if (!parseVersion(*string, string.Len(), *this, &compareOp)) {
+		SML::Logging::error(*FString::Printf(TEXT("Version string \"%s\" doesn't match the pattern"), *string));
+	} else if (!Parser::isDigit(string[0])) {
 		SML::Logging::error(TEXT("Unexpected comparison on version declaration"));
 	}
 }
@@ -46,13 +47,35 @@ FVersion::FVersion(const FString& string) {
 FVersionRange::FVersionRange() {}
 
 FVersionRange::FVersionRange(const FString& string) {
-	FString comparisonOp;
-	parseVersion(string, myVersion, &comparisonOp);
-	this->op = parseComparisonOp(comparisonOp);
+	const TCHAR* data = *string;
+	const int32 length = string.Len();
+	int32 pos = 0;
+	while (pos < length) {
+		//skip whitespace between comparators
+		if (FChar::IsWhitespace(data[pos])) {
+			pos++;
+			continue;
+		}
+		int32 end = pos;
+		while (end < length && !FChar::IsWhitespace(data[end])) {
+			end++;
+		}
+		FVersionComparator& comparator = comparators.AddDefaulted_GetRef();
+		if (!parseVersion(data + pos, end - pos, comparator.version, &comparator.op)) {
+			SML::Logging::error(*FString::Printf(TEXT("Version range \"%s\" doesn't match the pattern"), *string));
+			//malformed range doesn't match anything, instead of matching a part of what was intended
+			comparators.Empty();
+			return;
+		}
+		pos = end;
+	}
+	if (comparators.Num() == 0) {
+		SML::Logging::error(*FString::Printf(TEXT("Version range \"%s\" is empty"), *string));
+	}
 }
 
-bool FVersionRange::matches(const FVersion& version) const {
-	int result = version.compare(myVersion);
+bool FVersionComparator::matches(const FVersion& other) const {
+	int result = other.compare(version);
 	switch (op) {
 	case EComparisonOp::GREATER_EQUALS: return result >= 0;
 	case EComparisonOp::GREATER: return result > 0;
@@ -62,20 +85,21 @@ bool FVersionRange::matches(const FVersion& version) const {
 	}
 }
 
-void parseVersion(const FString& string, FVersion& version, FString* compareOp) {
-	std::wsmatch match;
-	const std::wstring wstr(*string);
-	std::regex_match(wstr, match, versionRegex);
-	if (match.empty()) {
-		SML::Logging::error(*FString::Printf(TEXT("Version string \"%s\" doesn't match the pattern"), *version.string()));
+FString FVersionComparator::string() const {
+	return comparisonString(this->op) + version.string();
+}
+
+bool FVersionRange::matches(const FVersion& version) const {
+	//empty range comes from an empty or malformed string, so it shouldn't silently accept any version
+	if (comparators.Num() == 0) {
+		return false;
+	}
+	for (const FVersionComparator& comparator : comparators) {
+		if (!comparator.matches(version)) {
+			return false;
+		}
 	}
-	if (compareOp != nullptr)
-		*compareOp = match[1].str().c_str();
-	version.major = std::stoull(match[2]);
-	version.minor = std::stoull(match[3]);
-	version.patch = std::stoull(match[4]);
-	version.type = match[5].str().c_str();
-	version.buildInfo = match[6].str().c_str();
+	return true;
 }
 
 FString FVersion::string() const {
@@ -91,7 +115,13 @@ FString FVersion::string() const {
 }
 
 FString FVersionRange::string() const {
-	return comparisonString(this->op) + myVersion.string();
+	FString result;
+	for (const FVersionComparator& comparator : comparators) {
+		if (!result.IsEmpty())
+			result.Append(TEXT(" "));
+		result.Append(comparator.string());
+	}
+	return result;
 }
 
 int FVersion::compare(const FVersion& other) const {
@@ -102,4 +132,4 @@ int FVersion::compare(const FVersion& other) const {
 	if (patch != other.patch)
 		return patch > other.patch ? 1 : -1;
 	return type.Compare(other.type);
-}
\ No newline at end of file
+}
@@ -1,16 +1,9 @@
 #pragma once
 #include <string>
+#include "mod/VersionParser.h"
 
 namespace SML {
 	namespace Versioning {
-		enum EComparisonOp {
-			EQUALS,
-			GREATER,
-			GREATER_EQUALS,
-			LESS,
-			LESS_EQUALS
-		};
-		
 		class FVersion {
 		public:
 			uint64_t major;
@@ -20,16 +13,33 @@ namespace SML {
 			FString buildInfo;
 
 			FVersion();
+			//invalid version strings are reported and result in 0.0.0
 			FVersion(const FString& string);
 		public:
 			FString string() const;
 
 			int compare(const FVersion& other) const;
 		};
+
+		/**
+		 * Single comparison against a version, like ">=1.2.0"
+		 */
+		struct FVersionComparator {
+			EComparisonOp op;
+			FVersion version;
+
+			FString string() const;
+			bool matches(const FVersion& version) const;
+		};
+
+		/**
+		 * Version range consisting of one or more space separated comparators,
+		 * all of which should match the version, for example ">=1.2.0 <2.0.0"
+		 * Empty or malformed ranges are reported and don't match any version
+		 */
 		class FVersionRange {
 		private:
-			EComparisonOp op;
-			FVersion myVersion;
+			TArray<FVersionComparator, TInlineAllocator<2>> comparators;
 		public:
 			FVersionRange();
 			FVersionRange(const FString& string);
@@ -37,6 +47,14 @@ namespace SML {
 			FString string() const;
 			bool matches(const FVersion& version) const;
 		};
+
+		/**
+		 * Parses SemVer version string, optionally prefixed with comparison operator (<=, <, >, >=, ^)
+		 * Accepts exactly the same syntax as SemVer 2.0.0 specification, without allocating
+		 * anything except for the pre-release and build metadata strings
+		 * Returns false if string is not a valid version, in which case outVersion is reset to 0.0.0
+		 */
+		bool parseVersion(const TCHAR* string, int32 length, FVersion& outVersion, EComparisonOp* outCompareOp);
 	};
 };
 		
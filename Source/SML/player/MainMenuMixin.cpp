@@ -18,6 +18,7 @@ TSharedRef<SWidget> CreateMenuInfoTextPanel() {
 	resultText.Add(FString::Printf(TEXT("Satisfactory Mod Loader v.%s"), *SML::getModLoaderVersion().string()));
 	resultText.Add(FString::Printf(TEXT("%llu mod(s) loaded"), modsLoaded));
 	resultText.Add(FString::Printf(TEXT("Bootstrapper v.%s"), *SML::getBootstrapperVersion().string()));
+	resultText.Add(FString::Printf(TEXT("Mod set: %s"), *modHandler.getModSetDigest().Left(12)));
 	if (SML::getSMLConfig().developmentMode) {
 		resultText.Add(TEXT("Development mode enabled."));
 	}
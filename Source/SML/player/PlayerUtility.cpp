@@ -6,13 +6,55 @@
 #include "mod/hooking.h"
 #include "player/component/SMLPlayerComponent.h"
 
+class APlayerStateProto {
+public: void SetPlayerName(const FString&) {}
+};
+
 namespace SML {
+	//connected player controllers by player name, updated on join, leave and rename
+	static TMap<FString, TWeakObjectPtr<AFGPlayerController>> playerNameIndex;
+	//reverse mapping, so we can drop previous name on rename or leave
+	static TMap<const AFGPlayerController*, FString> indexedPlayerNames;
+
+	void unindexPlayer(const AFGPlayerController* controller) {
+		FString previousName;
+		if (indexedPlayerNames.RemoveAndCopyValue(controller, previousName)) {
+			const TWeakObjectPtr<AFGPlayerController>* indexedController = playerNameIndex.Find(previousName);
+			if (indexedController != nullptr && indexedController->Get() == controller) {
+				playerNameIndex.Remove(previousName);
+			}
+		}
+	}
+
+	void indexPlayer(AFGPlayerController* controller) {
+		unindexPlayer(controller);
+		if (controller->PlayerState == nullptr) {
+			return;
+		}
+		const FString& playerName = controller->PlayerState->GetPlayerName();
+		playerNameIndex.Add(playerName, controller);
+		indexedPlayerNames.Add(controller, playerName);
+	}
+
 	void initializePlayerComponent() {
 		SUBSCRIBE_METHOD("?BeginPlay@AFGPlayerController@@UEAAXXZ", AFGPlayerController::BeginPlay, [](auto& scope, AFGPlayerController* controller) {
 			USMLPlayerComponent* component = NewObject<USMLPlayerComponent>(controller, TEXT("SML_PlayerComponent"));
 			component->RegisterComponent();
 			component->SetNetAddressable();
 			component->SetIsReplicated(true);
+			indexPlayer(controller);
+		});
+		SUBSCRIBE_METHOD("?Destroyed@AFGPlayerController@@UEAAXXZ", AFGPlayerController::Destroyed, [](auto& scope, AFGPlayerController* controller) {
+			unindexPlayer(controller);
+		});
+		SUBSCRIBE_METHOD("?SetPlayerName@APlayerState@@UEAAXAEBVFString@@@Z", APlayerStateProto::SetPlayerName, [](auto& scope, APlayerStateProto* playerStateProto, const FString& playerName) {
+			//let name change first, then reindex owning controller under the new name
+			scope(playerStateProto, playerName);
+			APlayerState* playerState = reinterpret_cast<APlayerState*>(playerStateProto);
+			AFGPlayerController* controller = Cast<AFGPlayerController>(playerState->GetOwner());
+			if (controller != nullptr) {
+				indexPlayer(controller);
+			}
 		});
 		SUBSCRIBE_METHOD("?EnterChatMessage@AFGPlayerController@@IEAAXAEBVFString@@@Z", AFGPlayerController::EnterChatMessage, [](auto& scope, AFGPlayerController* player, const FString& message) {
 			if (message.StartsWith(TEXT("/"))) {
@@ -40,12 +82,23 @@ namespace SML {
     }
 
 	SML_API AFGPlayerController* GetPlayerByName(const UWorld* world, const FString& playerName) {
-		TArray<AFGPlayerController*> connectedPlayers = getConnectedPlayers(world);
-    	for (AFGPlayerController* controller : connectedPlayers) {
-    		if (controller->PlayerState->GetPlayerName() == playerName) {
+		const TWeakObjectPtr<AFGPlayerController>* indexedController = playerNameIndex.Find(playerName);
+		if (indexedController != nullptr) {
+			AFGPlayerController* controller = indexedController->Get();
+			//index entry is only trusted if it still describes the controller, otherwise fall back to the full scan
+			if (controller != nullptr && controller->GetWorld() == world && controller->PlayerState != nullptr &&
+				controller->PlayerState->GetPlayerName() == playerName) {
 				return controller;
-    		}
-    	}
+			}
+		}
+		for (FConstPlayerControllerIterator iterator = world->GetPlayerControllerIterator(); iterator; iterator++) {
+			AFGPlayerController* controller = static_cast<AFGPlayerController*>((*iterator).Get());
+			if (controller != nullptr && controller->PlayerState != nullptr &&
+				controller->PlayerState->GetPlayerName() == playerName) {
+				indexPlayer(controller);
+				return controller;
+			}
+		}
 		return nullptr;
 	}
 };
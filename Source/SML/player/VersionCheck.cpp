@@ -28,21 +28,144 @@ public:
 	}
 };
 
-FString CreateModListString() {
-	//terribly inefficient due to multiple string copying and conversion, oh well.
+//version of the binary mod manifest format, bump when layout changes
+static const uint8 modManifestFormatVersion = 1;
+
+/**
+ * Entry of the mod manifest, describing a single loaded mod
+ * Manifest entries are sorted by modIdHash, so two manifests can be compared in a single pass
+ */
+struct FModManifestEntry {
+	uint64 modIdHash;
+	FString modid;
+	FVersion version;
+};
+
+//manifest of the locally loaded mods, and it's encoded form sent to the servers
+static TArray<FModManifestEntry> localModManifest;
+static FString encodedLocalModManifest;
+
+uint64 hashModId(const FString& modid) {
+	//64-bit FNV-1a over lower case UTF-16 code units, mod ids are case insensitive everywhere else
+	uint64 hash = 14695981039346656037ull;
+	for (const TCHAR character : modid) {
+		const uint16 codeUnit = static_cast<uint16>(FChar::ToLower(character));
+		hash = (hash ^ (codeUnit & 0xFF)) * 1099511628211ull;
+		hash = (hash ^ (codeUnit >> 8)) * 1099511628211ull;
+	}
+	return hash;
+}
+
+void writeVarInt(TArray<uint8>& buffer, uint64 value) {
+	while (value >= 0x80) {
+		buffer.Add(static_cast<uint8>(value | 0x80));
+		value >>= 7;
+	}
+	buffer.Add(static_cast<uint8>(value));
+}
+
+bool readVarInt(const TArray<uint8>& buffer, int32& offset, uint64& outValue) {
+	outValue = 0;
+	for (int32 shift = 0; shift < 64; shift += 7) {
+		if (offset >= buffer.Num()) {
+			return false;
+		}
+		const uint8 byte = buffer[offset++];
+		outValue |= static_cast<uint64>(byte & 0x7F) << shift;
+		if ((byte & 0x80) == 0) {
+			return true;
+		}
+	}
+	return false;
+}
+
+void SML::initializeModListManifest() {
 	SML::Mod::FModHandler& modHandler = SML::getModHandler();
-	FString resultString;
-	TSharedRef<TJsonWriter<>> writer = TJsonWriterFactory<>::Create(&resultString);
-	FJsonSerializer Serializer;
-	TSharedRef<FJsonObject> modListObject = MakeShareable(new FJsonObject());
+	localModManifest.Empty();
 	for (const FString& modid : modHandler.getLoadedMods()) {
-		const SML::Mod::FModInfo& info = modHandler.getLoadedMod(modid).modInfo;
-		modListObject->SetStringField(modid, info.version.string());
+		localModManifest.Add(FModManifestEntry{ hashModId(modid), modid, modHandler.getLoadedMod(modid).modInfo.version });
 	}
-	Serializer.Serialize(modListObject, writer);
-	return resultString;
+	localModManifest.Sort([](const FModManifestEntry& a, const FModManifestEntry& b) { return a.modIdHash < b.modIdHash; });
+
+	//layout: format version, mod count, then per mod: id hash, major, minor, patch and pre-release type
+	TArray<uint8> buffer;
+	buffer.Add(modManifestFormatVersion);
+	writeVarInt(buffer, localModManifest.Num());
+	for (const FModManifestEntry& entry : localModManifest) {
+		for (int32 i = 0; i < 8; i++) {
+			buffer.Add(static_cast<uint8>(entry.modIdHash >> (i * 8)));
+		}
+		writeVarInt(buffer, entry.version.major);
+		writeVarInt(buffer, entry.version.minor);
+		writeVarInt(buffer, entry.version.patch);
+		const FTCHARToUTF8 versionType(*entry.version.type);
+		writeVarInt(buffer, versionType.Length());
+		buffer.Append(reinterpret_cast<const uint8*>(versionType.Get()), versionType.Length());
+	}
+	encodedLocalModManifest = FBase64::Encode(buffer);
+	SML_LOG_DEBUG(SML::Logging::LogSML, TEXT("Mod list manifest size: "), buffer.Num(), TEXT(" bytes for "), localModManifest.Num(), TEXT(" mods"));
 }
 
+void CheckModManifest(const FString& encodedManifest, FString& failureReason) {
+	TArray<uint8> buffer;
+	if (!FBase64::Decode(encodedManifest, buffer) || buffer.Num() == 0 || buffer[0] != modManifestFormatVersion) {
+		failureReason = TEXT("Malformed Mod List Data");
+		return;
+	}
+	int32 offset = 1;
+	uint64 modCount;
+	if (!readVarInt(buffer, offset, modCount) || modCount > static_cast<uint64>(buffer.Num())) {
+		failureReason = TEXT("Malformed Mod List Data");
+		return;
+	}
+	//merge-join remote entries against local ones, both are sorted by mod id hash
+	TArray<FString> missingMods;
+	int32 localIndex = 0;
+	uint64 previousHash = 0;
+	for (uint64 i = 0; i < modCount; i++) {
+		if (offset + 8 > buffer.Num()) {
+			failureReason = TEXT("Malformed Mod List Data");
+			return;
+		}
+		uint64 modIdHash = 0;
+		for (int32 j = 0; j < 8; j++) {
+			modIdHash |= static_cast<uint64>(buffer[offset++]) << (j * 8);
+		}
+		FVersion remoteVersion;
+		uint64 typeLength;
+		if ((i > 0 && modIdHash <= previousHash) ||
+			!readVarInt(buffer, offset, remoteVersion.major) ||
+			!readVarInt(buffer, offset, remoteVersion.minor) ||
+			!readVarInt(buffer, offset, remoteVersion.patch) ||
+			!readVarInt(buffer, offset, typeLength) || typeLength > static_cast<uint64>(buffer.Num() - offset)) {
+			failureReason = TEXT("Malformed Mod List Data");
+			return;
+		}
+		previousHash = modIdHash;
+		while (localIndex < localModManifest.Num() && localModManifest[localIndex].modIdHash < modIdHash) {
+			missingMods.Add(FString::Printf(TEXT("%s: missing"), *localModManifest[localIndex++].modid));
+		}
+		if (localIndex < localModManifest.Num() && localModManifest[localIndex].modIdHash == modIdHash) {
+			if (typeLength > 0) {
+				const FUTF8ToTCHAR versionType(reinterpret_cast<const ANSICHAR*>(buffer.GetData() + offset), typeLength);
+				remoteVersion.type = FString(versionType.Length(), versionType.Get());
+			}
+			const FVersion& minModVersion = localModManifest[localIndex++].version;
+			if (remoteVersion.compare(minModVersion) < 0) {
+				missingMods.Add(FString::Printf(TEXT("%s: required at least %s"), *localModManifest[localIndex - 1].modid, *minModVersion.string()));
+			}
+		}
+		offset += typeLength;
+	}
+	while (localIndex < localModManifest.Num()) {
+		missingMods.Add(FString::Printf(TEXT("%s: missing"), *localModManifest[localIndex++].modid));
+	}
+	if (missingMods.Num() > 0) {
+		failureReason = FString(TEXT("Missing Mods on Client: \n")) += FString::Join(missingMods, TEXT("\n"));
+	}
+}
+
+//legacy mod list check, used for clients not sending binary manifest yet
 void CheckModListString(const FString& modListString, FString& failureReason) {
 	TSharedRef<TJsonReader<>> reader = TJsonReaderFactory<>::Create(modListString);
 	FJsonSerializer Serializer;
@@ -82,18 +205,31 @@ bool Base64Decode(const FString& Source, FString& OutDest) {
 	return true;
 }
 
+//returns value of the given ?Key= option of the url options string
+bool FindUrlOption(const FString& Options, const TCHAR* OptionPrefix, FString& OutValue) {
+	const int32 OptionIndex = Options.Find(OptionPrefix);
+	if (OptionIndex == INDEX_NONE) {
+		return false;
+	}
+	OutValue = Options.Mid(OptionIndex + FCString::Strlen(OptionPrefix));
+	int32 nextQuestionIndex;
+	if (OutValue.FindChar('?', nextQuestionIndex)) {
+		OutValue = OutValue.Mid(0, nextQuestionIndex);
+	}
+	return true;
+}
+
 void SML::registerVersionCheckHooks() {
 	SUBSCRIBE_METHOD("?PreLogin@AGameModeBase@@UEAAXAEBVFString@@0AEBUFUniqueNetIdRepl@@AEAV2@@Z", FunctionProto::PreLogin, [](auto& scope, FunctionProto* gm, const FString& Options, const FString& str, const FUniqueNetIdRepl& repl, FString* ErrorMessage) {
-		const int32 SmlModListIndex = Options.Find(TEXT("?SML_ModList="));
 		FString disconnectReason;
-		if (SmlModListIndex != INDEX_NONE) {
-			FString subString = Options.Mid(SmlModListIndex + 13);
-			int32 nextQuestionIndex;
-			if (subString.FindChar('?', nextQuestionIndex)) {
-				subString = subString.Mid(0, nextQuestionIndex);
-			}
+		FString optionValue;
+		if (FindUrlOption(Options, TEXT("?SML_ModDigest="), optionValue) && optionValue == SML::getModHandler().getModSetDigest()) {
+			//client has exactly the same mod set as we do, nothing to compare
+		} else if (FindUrlOption(Options, TEXT("?SML_ModManifest="), optionValue)) {
+			CheckModManifest(optionValue, disconnectReason);
+		} else if (FindUrlOption(Options, TEXT("?SML_ModList="), optionValue)) {
 			FString decodedString;
-			if (Base64Decode(subString, decodedString)) {
+			if (Base64Decode(optionValue, decodedString)) {
 				CheckModListString(decodedString, disconnectReason);
 			} else {
 				disconnectReason = TEXT("Malformed Mod List Data");
@@ -118,8 +254,7 @@ void SML::registerVersionCheckHooks() {
 	
 	SUBSCRIBE_METHOD("?Browse@UEngine@@UEAA?AW4Type@EBrowseReturnVal@@AEAUFWorldContext@@UFURL@@AEAVFString@@@Z", FunctionProto::Browse, [](auto& scope, FunctionProto* ptr, FWorldContext& world, FURL& URL, FString& Error) {
 		SML::Logging::info(TEXT("Connecting to URL "), *URL.ToString());
-		const FString& myModList = CreateModListString();
-		const FString& encodedModList = FBase64::Encode(myModList);
-		URL.AddOption(*(FString(TEXT("SML_ModList=")) += encodedModList));
+		URL.AddOption(*(FString(TEXT("SML_ModDigest=")) += SML::getModHandler().getModSetDigest()));
+		URL.AddOption(*(FString(TEXT("SML_ModManifest=")) += encodedLocalModManifest));
 	});
 }
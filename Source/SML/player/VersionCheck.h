@@ -14,4 +14,10 @@ public:
 
 namespace SML {
 	void registerVersionCheckHooks();
+
+	/**
+	 * Builds binary manifest of the loaded mods sent to the servers on connect
+	 * Should be called once mods are loaded
+	 */
+	void initializeModListManifest();
 }
\ No newline at end of file
@@ -5,6 +5,35 @@ void USMLPlayerComponent::HandleChatCommand_Implementation(const FString& comman
 	SML::ChatCommand::runChatCommand(commandLine, static_cast<AFGPlayerController*>(GetOwner()));
 }
 
+//minimum interval between completion requests served for a single player, in seconds
+static const float CompletionRequestInterval = 0.1f;
+//no command name is that long, so longer prefixes can't have any completions
+static const int32 MaxCompletionPrefixLength = 64;
+
+void USMLPlayerComponent::CompleteChatCommand_Implementation(const FString& partialCommandLine) {
+	//requests are sent while client is typing, so don't let a single client keep server busy with them
+	const float CurrentTime = GetWorld()->GetRealTimeSeconds();
+	if (LastCompletionRequestTime >= 0.0f && CurrentTime - LastCompletionRequestTime < CompletionRequestInterval) {
+		return;
+	}
+	LastCompletionRequestTime = CurrentTime;
+	//only command names are completed, so there is nothing to offer once arguments are being typed
+	int32 separatorIndex;
+	if (partialCommandLine.Len() > MaxCompletionPrefixLength || partialCommandLine.FindChar(TEXT(' '), separatorIndex)) {
+		ReceiveChatCommandCompletions(TArray<FString>());
+		return;
+	}
+	ReceiveChatCommandCompletions(SML::ChatCommand::getCommandCompletions(partialCommandLine));
+}
+
+bool USMLPlayerComponent::CompleteChatCommand_Validate(const FString& partialCommandLine) {
+	return true;
+}
+
+void USMLPlayerComponent::ReceiveChatCommandCompletions_Implementation(const TArray<FString>& completions) {
+	OnChatCommandCompletions.Broadcast(completions);
+}
+
 void USMLPlayerComponent::SendChatMessage_Implementation(const FString& message, const FLinearColor& color) {
 	AFGChatManager* chatManager = AFGChatManager::Get(GetWorld());
 	FChatMessageStruct messageStruct;
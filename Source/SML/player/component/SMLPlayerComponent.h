@@ -7,6 +7,8 @@
 #include "GameFramework/PlayerController.h"
 #include "SMLPlayerComponent.generated.h"
 
+DECLARE_DYNAMIC_MULTICAST_DELEGATE_OneParam(FOnChatCommandCompletions, const TArray<FString>&, completions);
+
 UCLASS(Blueprintable)
 class SML_API USMLPlayerComponent : public UActorComponent {
 	GENERATED_BODY()
@@ -20,6 +22,24 @@ public:
 	void HandleChatCommand(const FString& commandLine);
 
 	bool HandleChatCommand_Validate(const FString& commandLine);
+
+	/**
+	 * Called client side to request completions of the command name typed so far
+	 * Unreliable and rate limited on the server, requests arriving faster than 10 per second are ignored,
+	 * so request completions when they are needed (for example, on tab), not on every keystroke
+	 */
+	UFUNCTION(BlueprintCallable, Unreliable, Server, WithValidation = CompleteChatCommand_Validate)
+	void CompleteChatCommand(const FString& partialCommandLine);
+
+	bool CompleteChatCommand_Validate(const FString& partialCommandLine);
+
+	/** Delivers command name completions requested by CompleteChatCommand to the client */
+	UFUNCTION(Unreliable, Client)
+	void ReceiveChatCommandCompletions(const TArray<FString>& completions);
+
+	/** Broadcasted client side when command completions are received */
+	UPROPERTY(BlueprintAssignable)
+	FOnChatCommandCompletions OnChatCommandCompletions;
 	
 	/*
 	 * Returns USMLPlayerComponent instance attached
@@ -28,4 +48,7 @@ public:
 	 */
 	UFUNCTION(BlueprintPure)
 	static USMLPlayerComponent* Get(APlayerController* player);
+private:
+	/** Real time of the last completion request served for this player, used for rate limiting */
+	float LastCompletionRequestTime = -1.0f;
 };
\ No newline at end of file
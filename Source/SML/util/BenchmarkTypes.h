@@ -0,0 +1,113 @@
+#pragma once
+#include "CoreMinimal.h"
+#include "BenchmarkTypes.generated.h"
+
+/**
+ * Struct with 50 fields of all types supported by the json conversion of USMLBlueprintLibrary, used by its benchmark
+ * Field names carry the same two suffixes as properties of user defined structs, so json keys match the blueprint ones
+ */
+USTRUCT()
+struct FSMLBenchmarkStruct {
+	GENERATED_BODY()
+
+	UPROPERTY()
+	FString String0_0_0;
+	UPROPERTY()
+	FString String1_1_0;
+	UPROPERTY()
+	FString String2_2_0;
+	UPROPERTY()
+	FString String3_3_0;
+	UPROPERTY()
+	FString String4_4_0;
+	UPROPERTY()
+	FString String5_5_0;
+	UPROPERTY()
+	FString String6_6_0;
+	UPROPERTY()
+	FString String7_7_0;
+	UPROPERTY()
+	FString String8_8_0;
+	UPROPERTY()
+	FString String9_9_0;
+	UPROPERTY()
+	float Float0_0_0;
+	UPROPERTY()
+	float Float1_1_0;
+	UPROPERTY()
+	float Float2_2_0;
+	UPROPERTY()
+	float Float3_3_0;
+	UPROPERTY()
+	float Float4_4_0;
+	UPROPERTY()
+	float Float5_5_0;
+	UPROPERTY()
+	float Float6_6_0;
+	UPROPERTY()
+	float Float7_7_0;
+	UPROPERTY()
+	float Float8_8_0;
+	UPROPERTY()
+	float Float9_9_0;
+	UPROPERTY()
+	int32 Int0_0_0;
+	UPROPERTY()
+	int32 Int1_1_0;
+	UPROPERTY()
+	int32 Int2_2_0;
+	UPROPERTY()
+	int32 Int3_3_0;
+	UPROPERTY()
+	int32 Int4_4_0;
+	UPROPERTY()
+	int32 Int5_5_0;
+	UPROPERTY()
+	int32 Int6_6_0;
+	UPROPERTY()
+	int32 Int7_7_0;
+	UPROPERTY()
+	int32 Int8_8_0;
+	UPROPERTY()
+	int32 Int9_9_0;
+	UPROPERTY()
+	bool Bool0_0_0;
+	UPROPERTY()
+	bool Bool1_1_0;
+	UPROPERTY()
+	bool Bool2_2_0;
+	UPROPERTY()
+	bool Bool3_3_0;
+	UPROPERTY()
+	bool Bool4_4_0;
+	UPROPERTY()
+	bool Bool5_5_0;
+	UPROPERTY()
+	bool Bool6_6_0;
+	UPROPERTY()
+	bool Bool7_7_0;
+	UPROPERTY()
+	bool Bool8_8_0;
+	UPROPERTY()
+	bool Bool9_9_0;
+	UPROPERTY()
+	TArray<int32> Array0_0_0;
+	UPROPERTY()
+	TArray<int32> Array1_1_0;
+	UPROPERTY()
+	TArray<int32> Array2_2_0;
+	UPROPERTY()
+	TArray<int32> Array3_3_0;
+	UPROPERTY()
+	TArray<int32> Array4_4_0;
+	UPROPERTY()
+	TArray<int32> Array5_5_0;
+	UPROPERTY()
+	TArray<int32> Array6_6_0;
+	UPROPERTY()
+	TArray<int32> Array7_7_0;
+	UPROPERTY()
+	TArray<int32> Array8_8_0;
+	UPROPERTY()
+	TArray<int32> Array9_9_0;
+};
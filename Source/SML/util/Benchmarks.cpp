@@ -0,0 +1,125 @@
+#include "Benchmarks.h"
+#include "util/Logging.h"
+#include "util/TopologicalSort.h"
+#include "util/BenchmarkTypes.h"
+#include "mod/BlueprintLibrary.h"
+#include "UObject/UnrealType.h"
+#include "Math/RandomStream.h"
+#include <chrono>
+
+namespace SML {
+	namespace Benchmarks {
+		//fixed seed, so runs on different builds measure the same graph
+		static const int32 benchmarkSeed = 0x534D4C;
+
+		struct FBenchmarkTimes {
+			double bestSeconds = MAX_dbl;
+			double totalSeconds = 0.0;
+			int32 runs = 0;
+
+			void add(double seconds) {
+				bestSeconds = FMath::Min(bestSeconds, seconds);
+				totalSeconds += seconds;
+				runs++;
+			}
+
+			FString string() const {
+				return FString::Printf(TEXT("best %.3f ms, average %.3f ms over %d runs"), bestSeconds * 1000.0, totalSeconds * 1000.0 / runs, runs);
+			}
+		};
+
+		template<typename FuncType>
+		double timeSeconds(FuncType&& func) {
+			const auto startTime = std::chrono::steady_clock::now();
+			func();
+			return std::chrono::duration<double>(std::chrono::steady_clock::now() - startTime).count();
+		}
+
+		void benchmarkTopologicalSort(int32 nodeCount, int32 edgesPerNode, int32 iterations) {
+			FRandomStream random(benchmarkSeed);
+			//node values are shuffled, so insertion order doesn't match dependency order
+			TArray<uint64> nodeValues;
+			nodeValues.SetNumUninitialized(nodeCount);
+			for (int32 i = 0; i < nodeCount; i++) {
+				nodeValues[i] = i;
+			}
+			for (int32 i = nodeCount - 1; i > 0; i--) {
+				nodeValues.Swap(i, random.RandRange(0, i));
+			}
+			//edges only point to nodes with lower rank, so graph is always acyclic
+			TopologicalSort::DirectedGraph<uint64> graph;
+			for (int32 i = 0; i < nodeCount; i++) {
+				graph.addNode(nodeValues[i]);
+			}
+			for (int32 i = 1; i < nodeCount; i++) {
+				const int32 edgeCount = random.RandRange(0, edgesPerNode);
+				for (int32 j = 0; j < edgeCount; j++) {
+					graph.addEdge(nodeValues[i], nodeValues[random.RandRange(0, i - 1)]);
+				}
+			}
+
+			FBenchmarkTimes sortTimes;
+			FBenchmarkTimes levelTimes;
+			int32 levelCount = 0;
+			for (int32 i = 0; i < iterations; i++) {
+				sortTimes.add(timeSeconds([&graph]() {
+					TopologicalSort::topologicalSort(graph);
+				}));
+				levelTimes.add(timeSeconds([&graph, &levelCount]() {
+					levelCount = TopologicalSort::topologicalLevels(graph).Num();
+				}));
+			}
+			SML::Logging::info(*FString::Printf(TEXT("topologicalSort on %d nodes and %d edges: %s"), nodeCount, graph.edges.Num(), *sortTimes.string()));
+			SML::Logging::info(*FString::Printf(TEXT("topologicalLevels on %d nodes and %d edges, %d levels: %s"), nodeCount, graph.edges.Num(), levelCount, *levelTimes.string()));
+		}
+
+		void benchmarkStructJsonConversion(int32 conversionsPerIteration, int32 iterations) {
+			UScriptStruct* Struct = FSMLBenchmarkStruct::StaticStruct();
+			FSMLBenchmarkStruct value;
+			int32 fieldIndex = 0;
+			for (auto prop = TFieldIterator<UProperty>(Struct); prop; ++prop, ++fieldIndex) {
+				void* ptrToProp = prop->ContainerPtrToValuePtr<void>(&value);
+				if (UStrProperty* strProp = Cast<UStrProperty>(*prop)) {
+					strProp->SetPropertyValue(ptrToProp, FString::Printf(TEXT("Benchmark value %d"), fieldIndex));
+				} else if (UFloatProperty* floatProp = Cast<UFloatProperty>(*prop)) {
+					floatProp->SetPropertyValue(ptrToProp, fieldIndex * 0.5f);
+				} else if (UIntProperty* intProp = Cast<UIntProperty>(*prop)) {
+					intProp->SetPropertyValue(ptrToProp, fieldIndex);
+				} else if (UBoolProperty* boolProp = Cast<UBoolProperty>(*prop)) {
+					boolProp->SetPropertyValue(ptrToProp, fieldIndex % 2 == 0);
+				} else if (UArrayProperty* arrayProp = Cast<UArrayProperty>(*prop)) {
+					FScriptArrayHelper arrayHelper(arrayProp, ptrToProp);
+					arrayHelper.Resize(8);
+					for (int32 i = 0; i < arrayHelper.Num(); i++) {
+						*reinterpret_cast<int32*>(arrayHelper.GetRawPtr(i)) = fieldIndex + i;
+					}
+				}
+			}
+
+			FBenchmarkTimes toJsonTimes;
+			FBenchmarkTimes fromJsonTimes;
+			TSharedPtr<FJsonObject> json = USMLBlueprintLibrary::convertUStructToJsonObject(Struct, &value);
+			for (int32 i = 0; i < iterations; i++) {
+				toJsonTimes.add(timeSeconds([&]() {
+					for (int32 j = 0; j < conversionsPerIteration; j++) {
+						json = USMLBlueprintLibrary::convertUStructToJsonObject(Struct, &value);
+					}
+				}));
+				fromJsonTimes.add(timeSeconds([&]() {
+					for (int32 j = 0; j < conversionsPerIteration; j++) {
+						USMLBlueprintLibrary::convertJsonObjectToUStruct(json, Struct, &value);
+					}
+				}));
+			}
+			SML::Logging::info(*FString::Printf(TEXT("%d conversions of %d field struct to json: %s"), conversionsPerIteration, fieldIndex, *toJsonTimes.string()));
+			SML::Logging::info(*FString::Printf(TEXT("%d conversions of json to %d field struct: %s"), conversionsPerIteration, fieldIndex, *fromJsonTimes.string()));
+		}
+
+		void runAllBenchmarks() {
+			SML::Logging::info(TEXT("Running SML benchmarks..."));
+			benchmarkTopologicalSort();
+			benchmarkStructJsonConversion();
+			SML::Logging::info(TEXT("SML benchmarks finished"));
+		}
+	}
+}
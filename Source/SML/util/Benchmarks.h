@@ -0,0 +1,25 @@
+#pragma once
+#include "CoreMinimal.h"
+
+namespace SML {
+	namespace Benchmarks {
+		/**
+		 * Sorts a random dependency graph with the given amount of nodes, each having up to edgesPerNode
+		 * dependencies, with both topologicalSort and topologicalLevels, and logs the best and average time
+		 * Graph is acyclic and nodes are inserted in random order, like asset dependency graphs are
+		 */
+		void benchmarkTopologicalSort(int32 nodeCount = 100000, int32 edgesPerNode = 4, int32 iterations = 10);
+
+		/**
+		 * Converts struct with 50 fields (FSMLBenchmarkStruct) into json object and back with USMLBlueprintLibrary
+		 * conversionsPerIteration times in each direction, and logs the best and average time of each direction
+		 */
+		void benchmarkStructJsonConversion(int32 conversionsPerIteration = 1000, int32 iterations = 10);
+
+		/**
+		 * Runs all SML benchmarks with their default parameters, results are written into the SML log
+		 * Available from the "Run SML Benchmarks" entry of the editor File menu
+		 */
+		void runAllBenchmarks();
+	}
+}
@@ -0,0 +1,179 @@
+#include "BinaryLog.h"
+#include "SatisfactoryModLoader.h"
+#include "Containers/Queue.h"
+#include <atomic>
+#include <chrono>
+#include <fstream>
+#include <mutex>
+
+namespace SML {
+	namespace BinaryLog {
+		//strings longer than this are written inline, they are usually paths or other unique data
+		static const int32 maxInternedStringLength = 64;
+		//upper limit of the string dictionary size, strings are written inline afterwards
+		static const int32 maxInternedStrings = 65536;
+		//maximum amount of records waiting to be written before new entries are dropped
+		static const int32 maxPendingRecords = 65536;
+
+		static std::atomic<bool> binaryLogEnabled(false);
+		static std::ofstream* binaryLogStream;
+		static std::chrono::steady_clock::time_point binaryLogStartTime;
+
+		static TQueue<TArray<uint8>, EQueueMode::Mpsc> pendingRecords;
+		static std::atomic<int32> pendingRecordCount(0);
+		static std::atomic<uint64> droppedRecordCount(0);
+		//amount of dropped entries already recorded in the file, guarded by getLogMutex()
+		static uint64 reportedDroppedRecordCount = 0;
+
+		static std::mutex internedStringsMutex;
+		static TMap<FString, uint32> internedStrings;
+
+		void writeVarInt(TArray<uint8>& buffer, uint64 value) {
+			while (value >= 0x80) {
+				buffer.Add(static_cast<uint8>(value | 0x80));
+				value >>= 7;
+			}
+			buffer.Add(static_cast<uint8>(value));
+		}
+
+		void writeUTF8(TArray<uint8>& buffer, const TCHAR* string, int32 length) {
+			const FTCHARToUTF8 converted(string, length);
+			writeVarInt(buffer, converted.Length());
+			buffer.Append(reinterpret_cast<const uint8*>(converted.Get()), converted.Length());
+		}
+
+		void queueRecord(TArray<uint8>&& record) {
+			if (pendingRecordCount.fetch_add(1) >= maxPendingRecords) {
+				pendingRecordCount--;
+				droppedRecordCount++;
+				return;
+			}
+			pendingRecords.Enqueue(MoveTemp(record));
+		}
+
+		//returns id of the interned string, defining it if it is seen for the first time
+		//caller must hold internedStringsMutex
+		bool internStringUnsafe(const TCHAR* string, int32 length, uint32& outId) {
+			const FString key(length, string);
+			if (const uint32* existingId = internedStrings.Find(key)) {
+				outId = *existingId;
+				return true;
+			}
+			if (internedStrings.Num() >= maxInternedStrings) {
+				return false;
+			}
+			outId = internedStrings.Num();
+			internedStrings.Add(key, outId);
+			//definitions are never dropped, otherwise every entry referencing them would be unreadable
+			TArray<uint8> definition;
+			definition.Add(static_cast<uint8>(ERecordKind::StringDefinition));
+			writeVarInt(definition, outId);
+			writeUTF8(definition, string, length);
+			pendingRecordCount++;
+			pendingRecords.Enqueue(MoveTemp(definition));
+			return true;
+		}
+
+		FRecordBuilder::FRecordBuilder(uint8 logLevel) : internLock(internedStringsMutex, std::defer_lock) {
+			const auto elapsed = std::chrono::steady_clock::now() - binaryLogStartTime;
+			buffer.Add(static_cast<uint8>(ERecordKind::Entry));
+			writeVarInt(buffer, std::chrono::duration_cast<std::chrono::microseconds>(elapsed).count());
+			buffer.Add(logLevel);
+		}
+
+		void FRecordBuilder::addString(const TCHAR* string, int32 length) {
+			uint32 stringId;
+			if (length <= maxInternedStringLength && !internLock.owns_lock()) {
+				internLock.lock();
+			}
+			if (length <= maxInternedStringLength && internStringUnsafe(string, length, stringId)) {
+				buffer.Add(static_cast<uint8>(EArgumentTag::StringRef));
+				writeVarInt(buffer, stringId);
+			} else {
+				buffer.Add(static_cast<uint8>(EArgumentTag::StringInline));
+				writeUTF8(buffer, string, length);
+			}
+		}
+
+		void FRecordBuilder::addSigned(int64 value) {
+			buffer.Add(static_cast<uint8>(EArgumentTag::Signed));
+			writeVarInt(buffer, (static_cast<uint64>(value) << 1) ^ static_cast<uint64>(value >> 63));
+		}
+
+		void FRecordBuilder::addUnsigned(uint64 value) {
+			buffer.Add(static_cast<uint8>(EArgumentTag::Unsigned));
+			writeVarInt(buffer, value);
+		}
+
+		void FRecordBuilder::addDouble(double value) {
+			buffer.Add(static_cast<uint8>(EArgumentTag::Double));
+			buffer.Append(reinterpret_cast<const uint8*>(&value), sizeof(double));
+		}
+
+		void FRecordBuilder::submit(bool flushImmediately) {
+			buffer.Add(static_cast<uint8>(EArgumentTag::End));
+			//definitions of referenced strings are queued already, entry can't overtake them
+			if (internLock.owns_lock()) {
+				internLock.unlock();
+			}
+			queueRecord(MoveTemp(buffer));
+			if (flushImmediately) {
+				std::lock_guard<std::mutex> lock(getLogMutex());
+				drainPendingRecordsUnsafe();
+			}
+		}
+
+		bool isEnabled() {
+			return binaryLogEnabled.load(std::memory_order_relaxed);
+		}
+
+		uint64 getDroppedRecords() {
+			return droppedRecordCount.load();
+		}
+
+		bool openBinaryLog(const FString& filePath) {
+			std::ofstream* stream = new std::ofstream(*filePath, std::ios_base::out | std::ios_base::trunc | std::ios_base::binary);
+			if (!stream->is_open()) {
+				delete stream;
+				return false;
+			}
+			TArray<uint8> header;
+			header.Append(reinterpret_cast<const uint8*>("SMLB"), 4);
+			header.Add(FormatVersion);
+			const int64 startTimeMillis = (FDateTime::UtcNow() - FDateTime(1970, 1, 1)).GetTotalMilliseconds();
+			for (int32 i = 0; i < 8; i++) {
+				header.Add(static_cast<uint8>(startTimeMillis >> (i * 8)));
+			}
+			stream->write(reinterpret_cast<const char*>(header.GetData()), header.Num());
+			binaryLogStream = stream;
+			binaryLogStartTime = std::chrono::steady_clock::now();
+			binaryLogEnabled = true;
+			return true;
+		}
+
+		void drainPendingRecordsUnsafe() {
+			if (binaryLogStream == nullptr) {
+				return;
+			}
+			TArray<uint8> record;
+			int32 writtenRecords = 0;
+			while (pendingRecords.Dequeue(record)) {
+				binaryLogStream->write(reinterpret_cast<const char*>(record.GetData()), record.Num());
+				writtenRecords++;
+			}
+			pendingRecordCount -= writtenRecords;
+			//record the gap, so decoder can tell that entries are missing at this point
+			const uint64 droppedRecords = droppedRecordCount.load();
+			if (droppedRecords != reportedDroppedRecordCount) {
+				const auto elapsed = std::chrono::steady_clock::now() - binaryLogStartTime;
+				record.Reset();
+				record.Add(static_cast<uint8>(ERecordKind::Dropped));
+				writeVarInt(record, std::chrono::duration_cast<std::chrono::microseconds>(elapsed).count());
+				writeVarInt(record, droppedRecords - reportedDroppedRecordCount);
+				binaryLogStream->write(reinterpret_cast<const char*>(record.GetData()), record.Num());
+				reportedDroppedRecordCount = droppedRecords;
+			}
+			binaryLogStream->flush();
+		}
+	}
+}
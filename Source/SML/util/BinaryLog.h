@@ -0,0 +1,132 @@
+#pragma once
+#include "CoreMinimal.h"
+#include <mutex>
+#include <sstream>
+#include <type_traits>
+
+namespace SML {
+	namespace BinaryLog {
+		/**
+		 * Structured binary log file layout, all integers are little endian:
+		 *
+		 * Header: "SMLB" magic, uint8 format version, int64 unix time of the log start in milliseconds
+		 * Then a sequence of records, each starting with uint8 record kind:
+		 *   StringDefinition: varint string id, varint byte length, UTF-8 bytes
+		 *   Entry: varint microseconds since log start, uint8 log level, arguments, End tag
+		 *   Dropped: varint microseconds since log start, varint amount of entries dropped since the previous
+		 *     Dropped record because the queue was full. Written once the queue is drained, so it follows the gap
+		 * Each argument starts with an uint8 EArgumentTag followed by the payload:
+		 *   StringRef: varint id of the previously (or later, for concurrent writers) defined string
+		 *   StringInline: varint byte length, UTF-8 bytes
+		 *   Signed: zigzag encoded varint
+		 *   Unsigned: varint
+		 *   Double: 8 bytes IEEE 754
+		 *
+		 * Message text is a plain concatenation of all arguments, same as in the text log
+		 * Short strings are interned, so repeated message parts are written as a single small id
+		 * Use Tools/SMLLogDecoder to render the file as text or JSON lines
+		 */
+		static const uint8 FormatVersion = 2;
+
+		enum class ERecordKind : uint8 {
+			StringDefinition = 1,
+			Entry = 2,
+			Dropped = 3
+		};
+
+		enum class EArgumentTag : uint8 {
+			End = 0,
+			StringRef = 1,
+			StringInline = 2,
+			Signed = 3,
+			Unsigned = 4,
+			Double = 5
+		};
+
+		/**
+		 * Encodes a single log entry into the binary form and submits it into the binary log queue
+		 * String dictionary lock is taken by the first interned argument and held until submit,
+		 * so a record takes it at most once regardless of the amount of string arguments
+		 */
+		class SML_API FRecordBuilder {
+		private:
+			TArray<uint8> buffer;
+			std::unique_lock<std::mutex> internLock;
+		public:
+			explicit FRecordBuilder(uint8 logLevel);
+
+			void addString(const TCHAR* string, int32 length);
+			void addSigned(int64 value);
+			void addUnsigned(uint64 value);
+			void addDouble(double value);
+
+			inline void add(const TCHAR* string) { addString(string, FCString::Strlen(string)); }
+			inline void add(TCHAR* string) { add(static_cast<const TCHAR*>(string)); }
+			inline void add(const ANSICHAR* string) { add(ANSI_TO_TCHAR(string)); }
+			inline void add(ANSICHAR* string) { add(static_cast<const ANSICHAR*>(string)); }
+			inline void add(const FString& string) { addString(*string, string.Len()); }
+			inline void add(TCHAR character) { addString(&character, 1); }
+			inline void add(ANSICHAR character) { add(static_cast<TCHAR>(character)); }
+			inline void add(bool value) { addUnsigned(value ? 1 : 0); }
+
+			template<typename T>
+			typename std::enable_if<std::is_integral<T>::value && std::is_signed<T>::value>::type add(T value) {
+				addSigned(value);
+			}
+
+			template<typename T>
+			typename std::enable_if<std::is_integral<T>::value && std::is_unsigned<T>::value>::type add(T value) {
+				addUnsigned(value);
+			}
+
+			template<typename T>
+			typename std::enable_if<std::is_floating_point<T>::value>::type add(T value) {
+				addDouble(value);
+			}
+
+			//anything else is formatted the same way as in the text log
+			template<typename T>
+			typename std::enable_if<!std::is_arithmetic<T>::value>::type add(const T& value) {
+				std::wostringstream stream;
+				stream << value;
+				const std::wstring result = stream.str();
+				addString(result.c_str(), static_cast<int32>(result.size()));
+			}
+
+			inline void addAll() {}
+
+			template<typename First, typename ...Args>
+			void addAll(First &&arg0, Args &&...args) {
+				add(arg0);
+				addAll(std::forward<Args>(args)...);
+			}
+
+			/**
+			 * Finishes the entry and queues it for the background log writer
+			 * flushImmediately forces all pending records to be written before returning
+			 */
+			void submit(bool flushImmediately);
+		};
+
+		/**
+		 * Returns true if structured binary log output is active
+		 */
+		SML_API bool isEnabled();
+
+		/**
+		 * Returns total amount of entries dropped because binary log queue was full
+		 */
+		SML_API uint64 getDroppedRecords();
+
+		/**
+		 * Opens binary log file at the given path and switches log output into the binary mode
+		 * Returns false if file cannot be opened, in which case text log is kept
+		 */
+		bool openBinaryLog(const FString& filePath);
+
+		/**
+		 * Writes all pending records into the binary log file, caller must hold getLogMutex()
+		 */
+		void drainPendingRecordsUnsafe();
+	}
+}
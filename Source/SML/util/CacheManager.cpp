@@ -0,0 +1,137 @@
+#include "CacheManager.h"
+#include "SatisfactoryModLoader.h"
+#include "util/Logging.h"
+#include "Async/Async.h"
+#include "Misc/ScopeLock.h"
+#include "HAL/PlatformFilemanager.h"
+#include "Json.h"
+
+namespace SML {
+	namespace Cache {
+		//name of the manifest file inside of the cache directory
+		static const TCHAR* cacheManifestFileName = TEXT("manifest.json");
+
+		//entries of the cache directory used by this launch
+		static TSet<FString> usedCacheEntries;
+		static FCriticalSection usedCacheEntriesLock;
+
+		struct FCacheEntryInfo {
+			FString entryName;
+			int64 lastUseTime;
+			int64 totalSize;
+		};
+
+		void markCacheEntryUsed(const FString& entryName) {
+			FScopeLock lock(&usedCacheEntriesLock);
+			usedCacheEntries.Add(entryName);
+		}
+
+		TMap<FString, int64> readCacheManifest(const FString& manifestPath) {
+			TMap<FString, int64> lastUseTimes;
+			FString contents;
+			if (!FFileHelper::LoadFileToString(contents, *manifestPath)) {
+				return lastUseTimes;
+			}
+			const TSharedPtr<FJsonObject>& manifestJson = parseJsonLenient(contents);
+			if (!manifestJson.IsValid()) {
+				SML::Logging::warning(TEXT("Cache manifest is corrupted, rebuilding it"));
+				return lastUseTimes;
+			}
+			for (const auto& pair : manifestJson->Values) {
+				double lastUseTime;
+				if (pair.Value.IsValid() && pair.Value->TryGetNumber(lastUseTime)) {
+					lastUseTimes.Add(pair.Key, static_cast<int64>(lastUseTime));
+				}
+			}
+			return lastUseTimes;
+		}
+
+		void writeCacheManifest(const FString& manifestPath, const TArray<FCacheEntryInfo>& entries) {
+			TSharedRef<FJsonObject> manifestJson = MakeShareable(new FJsonObject());
+			for (const FCacheEntryInfo& entry : entries) {
+				manifestJson->SetNumberField(entry.entryName, entry.lastUseTime);
+			}
+			FString resultString;
+			TSharedRef<TJsonWriter<>> writer = TJsonWriterFactory<>::Create(&resultString);
+			FJsonSerializer::Serialize(manifestJson, writer);
+			//write into temporary file first so crash mid-write doesn't lose the manifest
+			const FString tempManifestPath = manifestPath + TEXT(".tmp");
+			if (FFileHelper::SaveStringToFile(resultString, *tempManifestPath)) {
+				IFileManager::Get().Move(*manifestPath, *tempManifestPath, true);
+			}
+		}
+
+		int64 computeDirectorySize(IPlatformFile& platformFile, const FString& directory) {
+			int64 totalSize = 0;
+			platformFile.IterateDirectoryStatRecursively(*directory, [&totalSize](const TCHAR*, const FFileStatData& statData) {
+				if (!statData.bIsDirectory) {
+					totalSize += statData.FileSize;
+				}
+				return true;
+			});
+			return totalSize;
+		}
+
+		void evictCacheEntries(const int64 maxCacheSize, const TSet<FString>& usedEntries) {
+			IPlatformFile& platformFile = FPlatformFileManager::Get().GetPlatformFile();
+			const FString cacheDirectory = getCacheDirectory();
+			const FString manifestPath = cacheDirectory / cacheManifestFileName;
+			const TMap<FString, int64> lastUseTimes = readCacheManifest(manifestPath);
+			const int64 currentTime = FDateTime::UtcNow().ToUnixTimestamp();
+
+			TArray<FCacheEntryInfo> entries;
+			int64 totalCacheSize = 0;
+			platformFile.IterateDirectoryStat(*cacheDirectory, [&](const TCHAR* path, const FFileStatData& statData) {
+				if (!statData.bIsDirectory) {
+					return true;
+				}
+				const FString entryName = FPaths::GetCleanFilename(path);
+				int64 lastUseTime;
+				if (usedEntries.Contains(entryName)) {
+					lastUseTime = currentTime;
+				} else if (const int64* recordedTime = lastUseTimes.Find(entryName)) {
+					lastUseTime = *recordedTime;
+				} else {
+					//entry predates the manifest, fall back to it's modification time
+					lastUseTime = statData.ModificationTime.ToUnixTimestamp();
+				}
+				const int64 entrySize = computeDirectorySize(platformFile, path);
+				entries.Add(FCacheEntryInfo{entryName, lastUseTime, entrySize});
+				totalCacheSize += entrySize;
+				return true;
+			});
+
+			if (maxCacheSize > 0 && totalCacheSize > maxCacheSize) {
+				//evict least recently used entries first
+				entries.Sort([](const FCacheEntryInfo& a, const FCacheEntryInfo& b) { return a.lastUseTime < b.lastUseTime; });
+				int32 evictedEntries = 0;
+				const int64 initialCacheSize = totalCacheSize;
+				for (int32 i = 0; i < entries.Num() && totalCacheSize > maxCacheSize; i++) {
+					const FCacheEntryInfo& entry = entries[i];
+					if (usedEntries.Contains(entry.entryName)) {
+						continue;
+					}
+					if (platformFile.DeleteDirectoryRecursively(*(cacheDirectory / entry.entryName))) {
+						totalCacheSize -= entry.totalSize;
+						entries.RemoveAt(i--);
+						evictedEntries++;
+					}
+				}
+				SML::Logging::info(*FString::Printf(TEXT("Evicted %d cache entries, cache size reduced from %lld to %lld bytes"), evictedEntries, initialCacheSize, totalCacheSize));
+			}
+			writeCacheManifest(manifestPath, entries);
+		}
+
+		void scheduleCacheEviction() {
+			const int64 maxCacheSize = getSMLConfig().maxCacheSizeMb * 1024 * 1024;
+			TSet<FString> usedEntries;
+			{
+				FScopeLock lock(&usedCacheEntriesLock);
+				usedEntries = usedCacheEntries;
+			}
+			Async<void>(EAsyncExecution::ThreadPool, [maxCacheSize, usedEntries]() {
+				evictCacheEntries(maxCacheSize, usedEntries);
+			});
+		}
+	}
+}
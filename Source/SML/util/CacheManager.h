@@ -0,0 +1,21 @@
+#pragma once
+#include "CoreMinimal.h"
+
+namespace SML {
+	namespace Cache {
+		/**
+		 * Records that the given entry of the cache directory was used by this game launch
+		 * Entry name is the name of the directory directly inside of getCacheDirectory()
+		 * Thread-safe, can be called from the archive extraction workers
+		 */
+		void markCacheEntryUsed(const FString& entryName);
+
+		/**
+		 * Updates cache manifest with the entries used by this launch and
+		 * evicts least recently used entries until cache fits into configured size budget
+		 * Entries used by this launch are never evicted, because their files are still loaded
+		 * Work is done on a background thread, so it should only be called after mod loading is complete
+		 */
+		void scheduleCacheEviction();
+	}
+}
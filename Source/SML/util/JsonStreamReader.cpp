@@ -0,0 +1,511 @@
+#include "JsonStreamReader.h"
+#include "HAL/PlatformFilemanager.h"
+#include "Async/MappedFileHandle.h"
+#include "FileHelper.h"
+#include "Misc/Parse.h"
+
+namespace SML {
+	namespace JsonStream {
+		FJsonPullParser::FJsonPullParser(const ANSICHAR* data, int64 size) :
+			data(data), size(size), position(0), tokenStart(0), token(EJsonToken::None), numberValue(0.0),
+			needsSeparator(false), afterKey(false), afterComma(false), hasRootValue(false) {
+			if (size >= 3 && data[0] == '\xEF' && data[1] == '\xBB' && data[2] == '\xBF') {
+				position = 3;
+			}
+		}
+
+		EJsonToken FJsonPullParser::fail(const TCHAR* message) {
+			errorMessage = FString::Printf(TEXT("%s at offset %lld"), message, tokenStart);
+			token = EJsonToken::Error;
+			return token;
+		}
+
+		void FJsonPullParser::skipWhitespace() {
+			while (position < size) {
+				const ANSICHAR character = data[position];
+				if (character != ' ' && character != '\t' && character != '\n' && character != '\r') {
+					break;
+				}
+				position++;
+			}
+		}
+
+		EJsonToken FJsonPullParser::next() {
+			if (token == EJsonToken::EndOfInput || token == EJsonToken::Error) {
+				return token;
+			}
+			skipWhitespace();
+			tokenStart = position;
+			if (containerStack.Num() == 0 && hasRootValue) {
+				if (position < size) {
+					return fail(TEXT("Unexpected data after root value"));
+				}
+				token = EJsonToken::EndOfInput;
+				return token;
+			}
+			if (position >= size) {
+				return fail(TEXT("Unexpected end of input"));
+			}
+			if (containerStack.Num() > 0) {
+				const bool inObject = containerStack.Last() == '{';
+				ANSICHAR character = data[position];
+				if (character == '}' || character == ']') {
+					if ((character == '}') != inObject) {
+						return fail(TEXT("Mismatched closing bracket"));
+					}
+					if (afterKey || afterComma) {
+						return fail(TEXT("Expected value"));
+					}
+					position++;
+					containerStack.Pop(false);
+					token = inObject ? EJsonToken::EndObject : EJsonToken::EndArray;
+					onValueFinished();
+					return token;
+				}
+				if (needsSeparator) {
+					if (character != ',') {
+						return fail(inObject ? TEXT("Expected ',' or '}'") : TEXT("Expected ',' or ']'"));
+					}
+					position++;
+					needsSeparator = false;
+					afterComma = true;
+					skipWhitespace();
+					tokenStart = position;
+					if (position >= size) {
+						return fail(TEXT("Unexpected end of input"));
+					}
+					character = data[position];
+				}
+				if (inObject && !afterKey) {
+					if (character != '"') {
+						return fail(TEXT("Expected object key"));
+					}
+					if (!parseString(true)) {
+						return token;
+					}
+					skipWhitespace();
+					if (position >= size || data[position] != ':') {
+						return fail(TEXT("Expected ':' after object key"));
+					}
+					position++;
+					afterKey = true;
+					afterComma = false;
+					token = EJsonToken::Key;
+					return token;
+				}
+			}
+			return parseValue();
+		}
+
+		EJsonToken FJsonPullParser::parseValue() {
+			afterKey = false;
+			afterComma = false;
+			switch (data[position]) {
+			case '{':
+			case '[':
+				containerStack.Push(data[position]);
+				token = data[position] == '{' ? EJsonToken::BeginObject : EJsonToken::BeginArray;
+				position++;
+				needsSeparator = false;
+				return token;
+			case '"':
+				if (!parseString(true)) {
+					return token;
+				}
+				token = EJsonToken::String;
+				break;
+			case 't':
+				if (!parseLiteral("true", 4)) {
+					return token;
+				}
+				token = EJsonToken::True;
+				break;
+			case 'f':
+				if (!parseLiteral("false", 5)) {
+					return token;
+				}
+				token = EJsonToken::False;
+				break;
+			case 'n':
+				if (!parseLiteral("null", 4)) {
+					return token;
+				}
+				token = EJsonToken::Null;
+				break;
+			default:
+				if (!parseNumber()) {
+					return token;
+				}
+				token = EJsonToken::Number;
+				break;
+			}
+			onValueFinished();
+			return token;
+		}
+
+		void FJsonPullParser::onValueFinished() {
+			if (containerStack.Num() > 0) {
+				needsSeparator = true;
+			} else {
+				hasRootValue = true;
+			}
+		}
+
+		bool FJsonPullParser::parseLiteral(const ANSICHAR* literal, int32 length) {
+			if (size - position < length || FCStringAnsi::Strncmp(data + position, literal, length) != 0) {
+				fail(TEXT("Unexpected character"));
+				return false;
+			}
+			position += length;
+			return true;
+		}
+
+		bool FJsonPullParser::parseNumber() {
+			const int64 numberStart = position;
+			const auto skipDigits = [this]() {
+				const int64 digitsStart = position;
+				while (position < size && data[position] >= '0' && data[position] <= '9') {
+					position++;
+				}
+				return position > digitsStart;
+			};
+			if (position < size && data[position] == '-') {
+				position++;
+			}
+			if (!skipDigits()) {
+				fail(TEXT("Unexpected character"));
+				return false;
+			}
+			if (position < size && data[position] == '.') {
+				position++;
+				if (!skipDigits()) {
+					fail(TEXT("Expected digits after decimal point"));
+					return false;
+				}
+			}
+			if (position < size && (data[position] == 'e' || data[position] == 'E')) {
+				position++;
+				if (position < size && (data[position] == '+' || data[position] == '-')) {
+					position++;
+				}
+				if (!skipDigits()) {
+					fail(TEXT("Expected exponent digits"));
+					return false;
+				}
+			}
+			//numbers are short, so copy them to get the null terminated string Atod wants
+			ANSICHAR numberString[64];
+			const int64 numberLength = FMath::Min<int64>(position - numberStart, ARRAY_COUNT(numberString) - 1);
+			FMemory::Memcpy(numberString, data + numberStart, numberLength);
+			numberString[numberLength] = '\0';
+			numberValue = FCStringAnsi::Atod(numberString);
+			return true;
+		}
+
+		void appendCodePoint(TArray<ANSICHAR>& buffer, uint32 codePoint) {
+			if (codePoint < 0x80) {
+				buffer.Add(static_cast<ANSICHAR>(codePoint));
+			} else if (codePoint < 0x800) {
+				buffer.Add(static_cast<ANSICHAR>(0xC0 | (codePoint >> 6)));
+				buffer.Add(static_cast<ANSICHAR>(0x80 | (codePoint & 0x3F)));
+			} else if (codePoint < 0x10000) {
+				buffer.Add(static_cast<ANSICHAR>(0xE0 | (codePoint >> 12)));
+				buffer.Add(static_cast<ANSICHAR>(0x80 | ((codePoint >> 6) & 0x3F)));
+				buffer.Add(static_cast<ANSICHAR>(0x80 | (codePoint & 0x3F)));
+			} else {
+				buffer.Add(static_cast<ANSICHAR>(0xF0 | (codePoint >> 18)));
+				buffer.Add(static_cast<ANSICHAR>(0x80 | ((codePoint >> 12) & 0x3F)));
+				buffer.Add(static_cast<ANSICHAR>(0x80 | ((codePoint >> 6) & 0x3F)));
+				buffer.Add(static_cast<ANSICHAR>(0x80 | (codePoint & 0x3F)));
+			}
+		}
+
+		bool parseHexQuad(const ANSICHAR* input, uint32& outValue) {
+			outValue = 0;
+			for (int32 i = 0; i < 4; i++) {
+				const ANSICHAR character = input[i];
+				if (!FChar::IsHexDigit(character)) {
+					return false;
+				}
+				outValue = (outValue << 4) | FParse::HexDigit(character);
+			}
+			return true;
+		}
+
+		bool FJsonPullParser::parseString(bool decode) {
+			//skip opening quote
+			position++;
+			const int64 contentStart = position;
+			bool hasEscapes = false;
+			decodeBuffer.Reset();
+			while (true) {
+				if (position >= size) {
+					fail(TEXT("Unterminated string"));
+					return false;
+				}
+				const ANSICHAR character = data[position];
+				if (character == '"') {
+					break;
+				}
+				if (static_cast<uint8>(character) < 0x20) {
+					fail(TEXT("Control character in string"));
+					return false;
+				}
+				if (character != '\\') {
+					if (hasEscapes && decode) {
+						decodeBuffer.Add(character);
+					}
+					position++;
+					continue;
+				}
+				//escape sequence, switch to decoding into the buffer
+				if (!hasEscapes && decode) {
+					decodeBuffer.Append(data + contentStart, static_cast<int32>(position - contentStart));
+				}
+				hasEscapes = true;
+				if (position + 1 >= size) {
+					fail(TEXT("Unterminated string"));
+					return false;
+				}
+				const ANSICHAR escaped = data[position + 1];
+				position += 2;
+				if (!decode) {
+					continue;
+				}
+				switch (escaped) {
+				case '"': decodeBuffer.Add('"'); break;
+				case '\\': decodeBuffer.Add('\\'); break;
+				case '/': decodeBuffer.Add('/'); break;
+				case 'b': decodeBuffer.Add('\b'); break;
+				case 'f': decodeBuffer.Add('\f'); break;
+				case 'n': decodeBuffer.Add('\n'); break;
+				case 'r': decodeBuffer.Add('\r'); break;
+				case 't': decodeBuffer.Add('\t'); break;
+				case 'u': {
+					uint32 codePoint;
+					if (size - position < 4 || !parseHexQuad(data + position, codePoint)) {
+						fail(TEXT("Invalid unicode escape"));
+						return false;
+					}
+					position += 4;
+					//combine surrogate pair into a single code point
+					uint32 lowSurrogate;
+					if (codePoint >= 0xD800 && codePoint <= 0xDBFF && size - position >= 6 &&
+						data[position] == '\\' && data[position + 1] == 'u' &&
+						parseHexQuad(data + position + 2, lowSurrogate) && lowSurrogate >= 0xDC00 && lowSurrogate <= 0xDFFF) {
+						codePoint = 0x10000 + ((codePoint - 0xD800) << 10) + (lowSurrogate - 0xDC00);
+						position += 6;
+					}
+					appendCodePoint(decodeBuffer, codePoint);
+					break;
+				}
+				default:
+					fail(TEXT("Invalid escape sequence"));
+					return false;
+				}
+			}
+			const int64 contentEnd = position;
+			//skip closing quote
+			position++;
+			if (!decode) {
+				return true;
+			}
+			const ANSICHAR* content = hasEscapes ? decodeBuffer.GetData() : data + contentStart;
+			const int32 contentLength = hasEscapes ? decodeBuffer.Num() : static_cast<int32>(contentEnd - contentStart);
+			if (contentLength == 0) {
+				stringValue.Reset();
+				return true;
+			}
+			const FUTF8ToTCHAR convertedString(content, contentLength);
+			stringValue = FString(convertedString.Length(), convertedString.Get());
+			return true;
+		}
+
+		bool FJsonPullParser::skipValue() {
+			if (token != EJsonToken::BeginObject && token != EJsonToken::BeginArray) {
+				return token != EJsonToken::Error && token != EJsonToken::EndOfInput && token != EJsonToken::None;
+			}
+			const int32 valueDepth = containerStack.Num();
+			while (true) {
+				//string values are not needed, so only scan them instead of going through next()
+				skipWhitespace();
+				if (needsSeparator && position < size && data[position] == ',') {
+					position++;
+					needsSeparator = false;
+					afterComma = true;
+					skipWhitespace();
+				}
+				const bool expectsKey = containerStack.Last() == '{' && !afterKey;
+				if (position < size && data[position] == '"' && !needsSeparator && !expectsKey) {
+					tokenStart = position;
+					if (!parseString(false)) {
+						return false;
+					}
+					afterKey = false;
+					afterComma = false;
+					token = EJsonToken::String;
+					onValueFinished();
+					continue;
+				}
+				const EJsonToken nextToken = next();
+				if (nextToken == EJsonToken::Error || nextToken == EJsonToken::EndOfInput) {
+					return false;
+				}
+				if ((nextToken == EJsonToken::EndObject || nextToken == EJsonToken::EndArray) && containerStack.Num() < valueDepth) {
+					return true;
+				}
+			}
+		}
+
+		bool FJsonPullParser::skipValueSpan(FJsonValueSpan& outSpan) {
+			const int64 valueStart = tokenStart;
+			if (!skipValue()) {
+				return false;
+			}
+			outSpan.offset = valueStart;
+			outSpan.length = position - valueStart;
+			return true;
+		}
+
+		TSharedPtr<FJsonValue> FJsonPullParser::readValue() {
+			switch (token) {
+			case EJsonToken::String:
+				return MakeShareable(new FJsonValueString(stringValue));
+			case EJsonToken::Number:
+				return MakeShareable(new FJsonValueNumber(numberValue));
+			case EJsonToken::True:
+			case EJsonToken::False:
+				return MakeShareable(new FJsonValueBoolean(getBool()));
+			case EJsonToken::Null:
+				return MakeShareable(new FJsonValueNull());
+			case EJsonToken::BeginArray: {
+				TArray<TSharedPtr<FJsonValue>> values;
+				while (next() != EJsonToken::EndArray) {
+					const TSharedPtr<FJsonValue> value = readValue();
+					if (!value.IsValid()) {
+						return TSharedPtr<FJsonValue>();
+					}
+					values.Add(value);
+				}
+				return MakeShareable(new FJsonValueArray(values));
+			}
+			case EJsonToken::BeginObject: {
+				TSharedPtr<FJsonObject> object = MakeShareable(new FJsonObject());
+				while (next() == EJsonToken::Key) {
+					const FString key = stringValue;
+					next();
+					const TSharedPtr<FJsonValue> value = readValue();
+					if (!value.IsValid()) {
+						return TSharedPtr<FJsonValue>();
+					}
+					object->SetField(key, value);
+				}
+				if (token != EJsonToken::EndObject) {
+					return TSharedPtr<FJsonValue>();
+				}
+				return MakeShareable(new FJsonValueObject(object));
+			}
+			default:
+				if (token != EJsonToken::Error) {
+					fail(TEXT("Expected value"));
+				}
+				return TSharedPtr<FJsonValue>();
+			}
+		}
+
+		TSharedPtr<FJsonObject> FJsonPullParser::readObject() {
+			if (token != EJsonToken::BeginObject) {
+				if (token != EJsonToken::Error) {
+					fail(TEXT("Expected object"));
+				}
+				return TSharedPtr<FJsonObject>();
+			}
+			const TSharedPtr<FJsonValue> value = readValue();
+			return value.IsValid() ? value->AsObject() : TSharedPtr<FJsonObject>();
+		}
+
+		bool parseJsonSax(const ANSICHAR* data, int64 size, IJsonSaxHandler& handler, FString* outErrorMessage) {
+			FJsonPullParser parser(data, size);
+			while (true) {
+				bool continueParsing = true;
+				switch (parser.next()) {
+				case EJsonToken::BeginObject: continueParsing = handler.onBeginObject(); break;
+				case EJsonToken::EndObject: continueParsing = handler.onEndObject(); break;
+				case EJsonToken::BeginArray: continueParsing = handler.onBeginArray(); break;
+				case EJsonToken::EndArray: continueParsing = handler.onEndArray(); break;
+				case EJsonToken::Key: continueParsing = handler.onKey(parser.getString()); break;
+				case EJsonToken::String: continueParsing = handler.onString(parser.getString()); break;
+				case EJsonToken::Number: continueParsing = handler.onNumber(parser.getNumber()); break;
+				case EJsonToken::True:
+				case EJsonToken::False: continueParsing = handler.onBoolean(parser.getBool()); break;
+				case EJsonToken::Null: continueParsing = handler.onNull(); break;
+				case EJsonToken::EndOfInput: return true;
+				default:
+					if (outErrorMessage != nullptr) {
+						*outErrorMessage = parser.getErrorMessage();
+					}
+					return false;
+				}
+				if (!continueParsing) {
+					if (outErrorMessage != nullptr) {
+						*outErrorMessage = TEXT("Parsing stopped by handler");
+					}
+					return false;
+				}
+			}
+		}
+
+		TSharedPtr<FJsonObject> parseJsonObject(const ANSICHAR* data, int64 size, FString* outErrorMessage) {
+			FJsonPullParser parser(data, size);
+			parser.next();
+			TSharedPtr<FJsonObject> result = parser.readObject();
+			//make sure there is nothing but whitespace after the object
+			if (result.IsValid() && parser.next() != EJsonToken::EndOfInput) {
+				result.Reset();
+			}
+			if (!result.IsValid() && outErrorMessage != nullptr) {
+				*outErrorMessage = parser.getErrorMessage();
+			}
+			return result;
+		}
+
+		FMappedJsonFile::FMappedJsonFile() {}
+
+		FMappedJsonFile::~FMappedJsonFile() {
+			//region has to be released before the handle it was mapped from
+			mappedRegion.Reset();
+			mappedHandle.Reset();
+		}
+
+		bool FMappedJsonFile::open(const FString& filePath) {
+			mappedRegion.Reset();
+			mappedHandle.Reset();
+			fileContents.Empty();
+			mappedHandle.Reset(FPlatformFileManager::Get().GetPlatformFile().OpenMapped(*filePath));
+			if (mappedHandle.IsValid() && mappedHandle->GetFileSize() > 0) {
+				mappedRegion.Reset(mappedHandle->MapRegion());
+				if (mappedRegion.IsValid()) {
+					return true;
+				}
+			}
+			mappedHandle.Reset();
+			return FFileHelper::LoadFileToArray(fileContents, *filePath);
+		}
+
+		const ANSICHAR* FMappedJsonFile::getData() const {
+			if (mappedRegion.IsValid()) {
+				return reinterpret_cast<const ANSICHAR*>(mappedRegion->GetMappedPtr());
+			}
+			return reinterpret_cast<const ANSICHAR*>(fileContents.GetData());
+		}
+
+		int64 FMappedJsonFile::getSize() const {
+			return mappedRegion.IsValid() ? mappedRegion->GetMappedSize() : fileContents.Num();
+		}
+
+		TSharedPtr<FJsonObject> FMappedJsonFile::readObjectAt(const FJsonValueSpan& span, FString* outErrorMessage) const {
+			check(span.offset >= 0 && span.offset + span.length <= getSize());
+			return parseJsonObject(getData() + span.offset, span.length, outErrorMessage);
+		}
+	}
+}
@@ -0,0 +1,174 @@
+#pragma once
+#include "CoreMinimal.h"
+#include "Json.h"
+
+class IMappedFileHandle;
+class IMappedFileRegion;
+
+namespace SML {
+	namespace JsonStream {
+		enum class EJsonToken : uint8 {
+			None,
+			BeginObject,
+			EndObject,
+			BeginArray,
+			EndArray,
+			Key,
+			String,
+			Number,
+			True,
+			False,
+			Null,
+			EndOfInput,
+			Error
+		};
+
+		/** Range of the input occupied by a single json value, relative to the start of the input */
+		struct FJsonValueSpan {
+			int64 offset;
+			int64 length;
+		};
+
+		/**
+		 * Pull parser reading json tokens one by one directly from the UTF-8 input
+		 * Only the current token is decoded, so memory usage does not depend on the input size
+		 * Input is not copied and must outlive the parser. UTF-8 BOM at the start of the input is skipped
+		 *
+		 * Example Usage:
+		 * FJsonPullParser parser(data, size);
+		 * if (parser.next() == EJsonToken::BeginObject) {
+		 *     while (parser.next() == EJsonToken::Key) {
+		 *         const FString key = parser.getString();
+		 *         parser.next();
+		 *         const TSharedPtr<FJsonValue> value = parser.readValue();
+		 *     }
+		 * }
+		 */
+		class SML_API FJsonPullParser {
+		private:
+			const ANSICHAR* data;
+			int64 size;
+			int64 position;
+			int64 tokenStart;
+			EJsonToken token;
+			FString stringValue;
+			double numberValue;
+			FString errorMessage;
+			//'{' or '[' for every currently open container
+			TArray<ANSICHAR> containerStack;
+			TArray<ANSICHAR> decodeBuffer;
+			bool needsSeparator;
+			bool afterKey;
+			bool afterComma;
+			bool hasRootValue;
+		public:
+			FJsonPullParser(const ANSICHAR* data, int64 size);
+
+			/** Advances to the next token and returns it. Once EndOfInput or Error is reached, it is returned forever */
+			EJsonToken next();
+
+			FORCEINLINE EJsonToken getToken() const { return token; }
+
+			/** Returns decoded key name or string value of the current token */
+			FORCEINLINE const FString& getString() const { return stringValue; }
+
+			FORCEINLINE double getNumber() const { return numberValue; }
+			FORCEINLINE bool getBool() const { return token == EJsonToken::True; }
+
+			/** Returns amount of containers currently open, including the one just opened by the current token */
+			FORCEINLINE int32 getDepth() const { return containerStack.Num(); }
+
+			/** Returns input offset of the current token start, and offset right after the last consumed token */
+			FORCEINLINE int64 getTokenOffset() const { return tokenStart; }
+			FORCEINLINE int64 getOffset() const { return position; }
+
+			FORCEINLINE const FString& getErrorMessage() const { return errorMessage; }
+
+			/**
+			 * Skips value starting at the current token, leaving parser at it's last token
+			 * Strings inside of skipped value are not decoded. Returns false if input is malformed
+			 */
+			bool skipValue();
+
+			/**
+			 * Reads value starting at the current token into the json object model, leaving parser at it's last token
+			 * Returns invalid pointer if input is malformed or current token does not start a value
+			 */
+			TSharedPtr<FJsonValue> readValue();
+
+			/** Same as readValue, but also fails if value is not an object */
+			TSharedPtr<FJsonObject> readObject();
+
+			/** Returns span of the value starting at the current token and skips it */
+			bool skipValueSpan(FJsonValueSpan& outSpan);
+		private:
+			EJsonToken fail(const TCHAR* message);
+			void skipWhitespace();
+			bool parseString(bool decode);
+			bool parseNumber();
+			bool parseLiteral(const ANSICHAR* literal, int32 length);
+			EJsonToken parseValue();
+			void onValueFinished();
+		};
+
+		/**
+		 * Receives events from parseJsonSax. Returning false from any of the callbacks stops parsing
+		 */
+		class SML_API IJsonSaxHandler {
+		public:
+			virtual ~IJsonSaxHandler() {}
+
+			virtual bool onBeginObject() { return true; }
+			virtual bool onEndObject() { return true; }
+			virtual bool onBeginArray() { return true; }
+			virtual bool onEndArray() { return true; }
+			virtual bool onKey(const FString& key) { return true; }
+			virtual bool onString(const FString& value) { return true; }
+			virtual bool onNumber(double value) { return true; }
+			virtual bool onBoolean(bool value) { return true; }
+			virtual bool onNull() { return true; }
+		};
+
+		/**
+		 * Parses UTF-8 json input, passing every token to the handler as soon as it is read
+		 * Returns false if input is malformed or handler stopped parsing
+		 */
+		SML_API bool parseJsonSax(const ANSICHAR* data, int64 size, IJsonSaxHandler& handler, FString* outErrorMessage = nullptr);
+
+		/**
+		 * Parses UTF-8 input consisting of a single json object
+		 * Returns invalid pointer if input is malformed or is not an object
+		 */
+		SML_API TSharedPtr<FJsonObject> parseJsonObject(const ANSICHAR* data, int64 size, FString* outErrorMessage = nullptr);
+
+		/**
+		 * Read-only json file mapped into memory, so large files can be parsed without reading them fully
+		 * Falls back to reading file into memory if platform file does not support mapping
+		 */
+		class SML_API FMappedJsonFile {
+		private:
+			TUniquePtr<IMappedFileHandle> mappedHandle;
+			TUniquePtr<IMappedFileRegion> mappedRegion;
+			TArray<uint8> fileContents;
+		public:
+			FMappedJsonFile();
+			~FMappedJsonFile();
+
+			FMappedJsonFile(const FMappedJsonFile&) = delete;
+			FMappedJsonFile& operator=(const FMappedJsonFile&) = delete;
+
+			/** Opens given file, returns false if it cannot be read */
+			bool open(const FString& filePath);
+
+			const ANSICHAR* getData() const;
+			int64 getSize() const;
+
+			FORCEINLINE FJsonPullParser createParser() const {
+				return FJsonPullParser(getData(), getSize());
+			}
+
+			/** Parses json object located at the given span of the file */
+			TSharedPtr<FJsonObject> readObjectAt(const FJsonValueSpan& span, FString* outErrorMessage = nullptr) const;
+		};
+	}
+}
@@ -0,0 +1,181 @@
+#include "Logging.h"
+#include "BinaryLog.h"
+#include "Containers/Queue.h"
+#include <atomic>
+#include <condition_variable>
+#include <thread>
+#include <chrono>
+#include <cstdlib>
+
+namespace SML {
+	namespace Logging {
+		//maximum amount of lines waiting to be written before new lines are dropped
+		static const int32 maxPendingLines = 65536;
+		//amount of pending lines which wakes writer thread before it's periodic flush
+		static const int32 writerWakeUpLines = 256;
+		//interval at which writer thread flushes pending lines even if there is only a few of them
+		static const std::chrono::milliseconds writerFlushInterval(100);
+
+		//lock-free multi producer single consumer queue, consumed only while holding getLogMutex()
+		static TQueue<FString, EQueueMode::Mpsc> pendingLines;
+		static std::atomic<int32> pendingLineCount(0);
+		static std::atomic<uint64> droppedLineCount(0);
+		//amount of dropped lines already reported in the log, guarded by getLogMutex()
+		static uint64 reportedDroppedLineCount = 0;
+		static std::atomic<bool> writerRunning(false);
+
+		static std::mutex writerWakeMutex;
+		static std::condition_variable writerWakeCondition;
+
+		SML_DEFINE_LOG_CATEGORY(LogSML);
+
+		//category registry is accessed through functions because categories are constructed during static initialization
+		struct FLogCategoryRegistry {
+			std::mutex mutex;
+			TArray<FLogCategory*> categories;
+			TMap<FString, LogType> configuredLevels;
+			LogType defaultLevel = Info;
+		};
+
+		FLogCategoryRegistry& getCategoryRegistry() {
+			static FLogCategoryRegistry registry;
+			return registry;
+		}
+
+		LogType resolveCategoryLevel(const FLogCategoryRegistry& registry, const TCHAR* categoryName) {
+			const LogType* configuredLevel = registry.configuredLevels.Find(categoryName);
+			return configuredLevel != nullptr ? *configuredLevel : registry.defaultLevel;
+		}
+
+		FLogCategory::FLogCategory(const TCHAR* name, bool prefixMessages) : name(name), prefixMessages(prefixMessages) {
+			FLogCategoryRegistry& registry = getCategoryRegistry();
+			std::lock_guard<std::mutex> lock(registry.mutex);
+			minLevel = resolveCategoryLevel(registry, name);
+			registry.categories.Add(this);
+		}
+
+		FLogCategory::~FLogCategory() {
+			FLogCategoryRegistry& registry = getCategoryRegistry();
+			std::lock_guard<std::mutex> lock(registry.mutex);
+			registry.categories.RemoveSingleSwap(this);
+		}
+
+		bool parseLogType(const FString& name, LogType& outType) {
+			static const LogType allTypes[] = {Debug, Info, Warning, Error, Fatal};
+			for (const LogType type : allTypes) {
+				if (name.Equals(getLogTypeStr(type), ESearchCase::IgnoreCase)) {
+					outType = type;
+					return true;
+				}
+			}
+			//getLogTypeStr returns shortened name for warning level
+			if (name.Equals(TEXT("warning"), ESearchCase::IgnoreCase)) {
+				outType = Warning;
+				return true;
+			}
+			return false;
+		}
+
+		void applyLogCategoryLevels(const FSMLConfiguration& config) {
+			TArray<FString> invalidEntries;
+			{
+				FLogCategoryRegistry& registry = getCategoryRegistry();
+				std::lock_guard<std::mutex> lock(registry.mutex);
+				registry.defaultLevel = config.debugLogOutput ? Debug : Info;
+				registry.configuredLevels.Empty();
+				for (const FString& entry : config.logCategoryLevels) {
+					FString categoryName;
+					FString levelName;
+					LogType level;
+					if (!entry.Split(TEXT("="), &categoryName, &levelName) || !parseLogType(levelName.TrimStartAndEnd(), level)) {
+						invalidEntries.Add(entry);
+						continue;
+					}
+					registry.configuredLevels.Add(categoryName.TrimStartAndEnd(), level);
+				}
+				for (FLogCategory* category : registry.categories) {
+					category->setMinLevel(resolveCategoryLevel(registry, category->name));
+				}
+			}
+			for (const FString& entry : invalidEntries) {
+				warning(TEXT("Invalid log category level entry in SML config: "), *entry);
+			}
+		}
+
+		void writeLineUnsafe(const FString& line) {
+			std::wcout << *line << L'\n';
+			getLogFile() << *line << L'\n';
+		}
+
+		//writes all pending lines, caller must hold getLogMutex()
+		void drainPendingLinesUnsafe() {
+			FString line;
+			int32 writtenLines = 0;
+			while (pendingLines.Dequeue(line)) {
+				writeLineUnsafe(line);
+				writtenLines++;
+			}
+			pendingLineCount -= writtenLines;
+			const uint64 droppedLines = droppedLineCount.load();
+			if (droppedLines != reportedDroppedLineCount) {
+				writeLineUnsafe(FString::Printf(TEXT("[%s] Log queue overflow, dropped %llu line(s)"), getLogTypeStr(Warning), droppedLines - reportedDroppedLineCount));
+				reportedDroppedLineCount = droppedLines;
+			}
+			std::wcout.flush();
+			getLogFile().flush();
+			BinaryLog::drainPendingRecordsUnsafe();
+		}
+
+		void writerThreadLoop() {
+			while (true) {
+				{
+					std::unique_lock<std::mutex> wakeLock(writerWakeMutex);
+					writerWakeCondition.wait_for(wakeLock, writerFlushInterval, []() { return pendingLineCount.load() >= writerWakeUpLines; });
+				}
+				std::lock_guard<std::mutex> lock(getLogMutex());
+				drainPendingLinesUnsafe();
+			}
+		}
+
+		void writeLogLine(FString&& line, bool flushImmediately) {
+			if (!writerRunning || flushImmediately) {
+				std::lock_guard<std::mutex> lock(getLogMutex());
+				drainPendingLinesUnsafe();
+				writeLineUnsafe(line);
+				std::wcout.flush();
+				getLogFile().flush();
+				return;
+			}
+			const int32 previousCount = pendingLineCount.fetch_add(1);
+			if (previousCount >= maxPendingLines) {
+				pendingLineCount--;
+				droppedLineCount++;
+				return;
+			}
+			pendingLines.Enqueue(MoveTemp(line));
+			//only wake writer once per batch to avoid signaling it for every line
+			if (previousCount + 1 == writerWakeUpLines) {
+				writerWakeCondition.notify_one();
+			}
+		}
+
+		void flushLogOutput() {
+			std::lock_guard<std::mutex> lock(getLogMutex());
+			drainPendingLinesUnsafe();
+		}
+
+		uint64 getDroppedLogLines() {
+			return droppedLineCount.load();
+		}
+
+		void startAsyncLogWriter() {
+			bool expected = false;
+			if (!writerRunning.compare_exchange_strong(expected, true)) {
+				return;
+			}
+			//writer thread lives as long as the process, flush what is left on normal exit
+			std::thread(writerThreadLoop).detach();
+			std::atexit(flushLogOutput);
+		}
+	}
+}
@@ -2,9 +2,21 @@
 
 #include <iostream>
 #include "util/Utility.h"
+#include "util/BinaryLog.h"
 #include "SatisfactoryModLoader.h"
 #include "CoreTypes.h"
 #include <fstream>
+#include <atomic>
+
+/**
+ * Minimum log level compiled into the binary, calls to SML_LOG below it are stripped completely
+ * Defaults to Debug because the game and mods are always built in shipping configuration,
+ * so stripping debug there would make "debug" config option useless. Define it in your module's
+ * Build.cs (for example, PublicDefinitions.Add("SML_LOG_MIN_COMPILE_LEVEL=1")) to strip debug calls
+ */
+#ifndef SML_LOG_MIN_COMPILE_LEVEL
+#define SML_LOG_MIN_COMPILE_LEVEL 0
+#endif
 
 namespace SML {
 	namespace Logging
@@ -29,23 +41,113 @@ namespace SML {
 		}
 		
 		const TCHAR* getLogTypeStr(LogType type);
+
+		/**
+		 * Parses log level name as used in the configuration (debug, info, warning, error, fatal)
+		 * Returns false if name doesn't match any level
+		 */
+		SML_API bool parseLogType(const FString& name, LogType& outType);
+
+		/**
+		 * Named log category with the minimum level adjustable at runtime
+		 * Levels are configured by "logCategoryLevels" entries in the SML config,
+		 * each entry having "<Category>=<level>" format. Categories without
+		 * explicit level use debug if "debug" option is enabled, and info otherwise
+		 * Define categories once with SML_DEFINE_LOG_CATEGORY and use them with SML_LOG
+		 * Messages keep the plain log line format unless category is defined with
+		 * SML_DEFINE_PREFIXED_LOG_CATEGORY, which prefixes them with "[CategoryName] "
+		 */
+		class SML_API FLogCategory {
+		public:
+			const TCHAR* const name;
+			const bool prefixMessages;
+		private:
+			std::atomic<int32> minLevel;
+		public:
+			explicit FLogCategory(const TCHAR* name, bool prefixMessages = false);
+			~FLogCategory();
+
+			FLogCategory(const FLogCategory&) = delete;
+			FLogCategory& operator=(const FLogCategory&) = delete;
+
+			inline bool isEnabled(LogType type) const {
+				return type >= minLevel.load(std::memory_order_relaxed);
+			}
+
+			inline void setMinLevel(LogType level) {
+				minLevel.store(level, std::memory_order_relaxed);
+			}
+		};
+
+		/**
+		 * Applies per-category levels from SML configuration to all registered categories
+		 * Categories registered later pick up their levels automatically
+		 */
+		void applyLogCategoryLevels(const FSMLConfiguration& config);
+
+		/** Default category used by SML itself and by SML::Logging::debug */
+		SML_API extern FLogCategory LogSML;
+
+		/**
+		 * Writes preformatted line into the SML log file and console
+		 * Once async log writer is started, line is queued and written in batches by the background thread,
+		 * otherwise it is written synchronously. If queue is full, line is dropped and counted
+		 * flushImmediately forces all queued lines and this one to be written before returning
+		 */
+		SML_API void writeLogLine(FString&& line, bool flushImmediately = false);
+
+		/**
+		 * Starts background thread writing queued log lines
+		 * Called once during bootstrap right after log file is opened
+		 */
+		void startAsyncLogWriter();
+
+		/**
+		 * Synchronously writes all queued log lines and flushes log file and console
+		 */
+		SML_API void flushLogOutput();
+
+		/**
+		 * Returns total amount of log lines dropped because log queue was full
+		 */
+		SML_API uint64 getDroppedLogLines();
 		
 		// logs a message of <T> with various modifiers
 		template<typename First, typename ...Args>
 		void log(LogType type, First &&arg0, Args &&...args) {
+#if WITH_EDITOR == 0
+			const bool binaryLogEnabled = BinaryLog::isEnabled();
+			if (binaryLogEnabled) {
+				BinaryLog::FRecordBuilder record(static_cast<uint8>(type));
+				record.addAll(arg0, args...);
+				record.submit(type == LogType::Fatal);
+			}
+#endif
 			FString message = formatStr(arg0, args...);
 #if WITH_EDITOR == 0
-			const FString result = FString::Printf(TEXT("[%s] %s"), getLogTypeStr(type), *message);
-			std::wcout << *result << std::endl;
-			getLogFile() << *result << std::endl;
+			//binary log replaces the text log file, but fatal messages are still written there for crash reports
+			if (!binaryLogEnabled || type == LogType::Fatal) {
+				//fatal messages are usually followed by the process exit, so make sure they reach the file
+				writeLogLine(FString::Printf(TEXT("[%s] %s"), getLogTypeStr(type), *message), type == LogType::Fatal);
+			}
 #endif
 			const ELogVerbosity::Type verbosity = logTypeToVerbosity(type);
 			FMsg::Logf(nullptr, 0, FName(TEXT("SatisfactoryModLoader")), verbosity, TEXT("%s"), *message);
 		}
 
+		// logs a message into the category, prefer SML_LOG which skips argument evaluation
+		template<typename First, typename ...Args>
+		void logCategory(const FLogCategory& category, LogType type, First &&arg0, Args &&...args) {
+			if (category.prefixMessages) {
+				log(type, TEXT("["), category.name, TEXT("] "), arg0, args...);
+			} else {
+				log(type, arg0, args...);
+			}
+		}
+
 		template<typename First, typename ...Args>
 		void debug(First &&arg0, Args &&...args) {
-			if (getSMLConfig().debugLogOutput) {
+			if (LogSML.isEnabled(LogType::Debug)) {
 				log(LogType::Debug, arg0, args...);
 			}
 		}
@@ -81,4 +183,28 @@ namespace SML {
 			}
 		}
 	}
-}
\ No newline at end of file
+}
+
+/** Defines log category with the given name, should be placed in a single translation unit */
+#define SML_DEFINE_LOG_CATEGORY(CategoryName) SML::Logging::FLogCategory CategoryName(TEXT(#CategoryName))
+
+/** Defines log category which prefixes it's messages with "[CategoryName] ", should be placed in a single translation unit */
+#define SML_DEFINE_PREFIXED_LOG_CATEGORY(CategoryName) SML::Logging::FLogCategory CategoryName(TEXT(#CategoryName), true)
+
+/** Declares log category defined elsewhere, to be used in headers */
+#define SML_DECLARE_LOG_CATEGORY_EXTERN(CategoryName) extern SML::Logging::FLogCategory CategoryName
+
+/**
+ * Logs message with the given level into the given category
+ * Arguments are only evaluated and formatted if the level is enabled for the category,
+ * and calls below SML_LOG_MIN_COMPILE_LEVEL are stripped by the compiler
+ * Example: SML_LOG(SML::Logging::LogSML, Debug, TEXT("Loaded "), count, TEXT(" mods"));
+ */
+#define SML_LOG(Category, Level, ...) \
+	do { \
+		if (SML::Logging::Level >= SML_LOG_MIN_COMPILE_LEVEL && (Category).isEnabled(SML::Logging::Level)) { \
+			SML::Logging::logCategory(Category, SML::Logging::Level, __VA_ARGS__); \
+		} \
+	} while (false)
+
+#define SML_LOG_DEBUG(Category, ...) SML_LOG(Category, Debug, __VA_ARGS__)
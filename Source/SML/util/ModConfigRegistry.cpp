@@ -0,0 +1,312 @@
+#include "ModConfigRegistry.h"
+#include "util/Utility.h"
+#include "util/Logging.h"
+#include "Async/Async.h"
+#include "Containers/Ticker.h"
+#include "HAL/FileManager.h"
+#include "Misc/CoreDelegates.h"
+#include "Misc/ScopeLock.h"
+
+namespace SML {
+	namespace Config {
+		//how often loaded config files are checked for modifications on disk, in seconds
+		static const float configPollInterval = 1.0f;
+		//how long config should stay unchanged before it is written to disk, in seconds
+		static const double configWriteDelay = 1.0;
+
+		struct FModConfigEntry {
+			FString filePath;
+			TSharedPtr<FJsonObject> defaultValues;
+			TSharedPtr<FJsonObject> json;
+			//every value of the config by its dotted key path, including nested objects themselves
+			TMap<FString, TSharedPtr<FJsonValue>> flatValues;
+			FDateTime fileTimestamp;
+			bool hasPendingWrite = false;
+			double lastChangeTime = 0.0;
+		};
+
+		struct FConfigSubscription {
+			FString modid;
+			FString key;
+			FConfigChangeCallback callback;
+		};
+
+		struct FConfigChange {
+			FString modid;
+			FString key;
+			TSharedPtr<FJsonValue> newValue;
+		};
+
+		static FCriticalSection configRegistryLock;
+		static TMap<FString, FModConfigEntry> loadedConfigs;
+		static TMap<int32, FConfigSubscription> configSubscriptions;
+		static int32 lastSubscriptionHandle = 0;
+		static FDelegateHandle configTickerHandle;
+		//set once engine is initialized, before that neither ticker nor platform time can be used
+		static bool configRegistryStarted = false;
+
+		void flattenConfigValues(const FString& prefix, const TSharedPtr<FJsonObject>& object, TMap<FString, TSharedPtr<FJsonValue>>& flatValues) {
+			for (const auto& pair : object->Values) {
+				const FString key = prefix.IsEmpty() ? pair.Key : prefix + TEXT(".") + pair.Key;
+				flatValues.Add(key, pair.Value);
+				if (pair.Value.IsValid() && pair.Value->Type == EJson::Object) {
+					flattenConfigValues(key, pair.Value->AsObject(), flatValues);
+				}
+			}
+		}
+
+		bool configValuesEqual(const TSharedPtr<FJsonValue>& a, const TSharedPtr<FJsonValue>& b) {
+			if (!a.IsValid() || !b.IsValid()) {
+				return a.IsValid() == b.IsValid();
+			}
+			return FJsonValue::CompareEqual(*a, *b);
+		}
+
+		//rebuilds flattened values of the entry, recording keys whose values differ from previous ones
+		void updateFlatValues(const FString& modid, FModConfigEntry& entry, TArray<FConfigChange>& changes) {
+			TMap<FString, TSharedPtr<FJsonValue>> previousValues = MoveTemp(entry.flatValues);
+			entry.flatValues.Reset();
+			flattenConfigValues(TEXT(""), entry.json, entry.flatValues);
+			for (const auto& pair : entry.flatValues) {
+				const TSharedPtr<FJsonValue>* previousValue = previousValues.Find(pair.Key);
+				if (previousValue == nullptr || !configValuesEqual(*previousValue, pair.Value)) {
+					changes.Add(FConfigChange{ modid, pair.Key, pair.Value });
+				}
+			}
+			for (const auto& pair : previousValues) {
+				if (!entry.flatValues.Contains(pair.Key)) {
+					changes.Add(FConfigChange{ modid, pair.Key, nullptr });
+				}
+			}
+		}
+
+		void markConfigChanged(FModConfigEntry& entry) {
+			entry.hasPendingWrite = true;
+			//changes made before registry is started are written on it's first tick
+			entry.lastChangeTime = configRegistryStarted ? FPlatformTime::Seconds() : 0.0;
+		}
+
+		//reads config file of the entry, falling back to default values if it is missing or corrupted
+		void loadConfigEntry(const FString& modid, FModConfigEntry& entry) {
+			TSharedPtr<FJsonObject> loadedJson;
+			FString contents;
+			if (FFileHelper::LoadFileToString(contents, *entry.filePath)) {
+				loadedJson = parseJsonLenient(contents);
+			}
+			entry.fileTimestamp = IFileManager::Get().GetTimeStamp(*entry.filePath);
+			if (!loadedJson.IsValid()) {
+				entry.json = entry.defaultValues;
+				markConfigChanged(entry);
+				return;
+			}
+			entry.json = loadedJson;
+			if (setDefaultValues(entry.json, entry.defaultValues)) {
+				markConfigChanged(entry);
+			}
+		}
+
+		void writeConfigEntry(FModConfigEntry& entry) {
+			FString resultString;
+			TSharedRef<TJsonWriter<>> writer = TJsonWriterFactory<>::Create(&resultString);
+			FJsonSerializer::Serialize(entry.json.ToSharedRef(), writer);
+			//write into temporary file first, so readers never observe partially written config
+			const FString tempFilePath = entry.filePath + TEXT(".tmp");
+			if (FFileHelper::SaveStringToFile(resultString, *tempFilePath) &&
+				IFileManager::Get().Move(*entry.filePath, *tempFilePath, true)) {
+				entry.fileTimestamp = IFileManager::Get().GetTimeStamp(*entry.filePath);
+			} else {
+				SML::Logging::error(TEXT("Failed to write mod config file "), *entry.filePath);
+			}
+			entry.hasPendingWrite = false;
+		}
+
+		void notifySubscribers(const TArray<FConfigChange>& changes) {
+			if (changes.Num() == 0) {
+				return;
+			}
+			if (!IsInGameThread()) {
+				AsyncTask(ENamedThreads::GameThread, [changes]() { notifySubscribers(changes); });
+				return;
+			}
+			//copy subscriptions, so callbacks are free to subscribe or unsubscribe
+			TArray<FConfigSubscription> subscriptions;
+			{
+				FScopeLock lock(&configRegistryLock);
+				configSubscriptions.GenerateValueArray(subscriptions);
+			}
+			for (const FConfigChange& change : changes) {
+				for (const FConfigSubscription& subscription : subscriptions) {
+					if (subscription.modid == change.modid && (subscription.key.IsEmpty() || subscription.key == change.key)) {
+						subscription.callback(change.modid, change.key, change.newValue);
+					}
+				}
+			}
+		}
+
+		bool tickConfigRegistry(float) {
+			TArray<FConfigChange> changes;
+			{
+				FScopeLock lock(&configRegistryLock);
+				const double currentTime = FPlatformTime::Seconds();
+				for (auto& pair : loadedConfigs) {
+					FModConfigEntry& entry = pair.Value;
+					//pending in-memory changes take priority over the file, they will overwrite it shortly anyway
+					if (entry.hasPendingWrite) {
+						if (currentTime - entry.lastChangeTime >= configWriteDelay) {
+							writeConfigEntry(entry);
+						}
+						continue;
+					}
+					const FDateTime fileTimestamp = IFileManager::Get().GetTimeStamp(*entry.filePath);
+					if (fileTimestamp != entry.fileTimestamp) {
+						SML_LOG_DEBUG(SML::Logging::LogSML, TEXT("Reloading modified config of mod "), *pair.Key);
+						loadConfigEntry(pair.Key, entry);
+						updateFlatValues(pair.Key, entry, changes);
+					}
+				}
+			}
+			notifySubscribers(changes);
+			return true;
+		}
+
+		FModConfigEntry& findOrLoadConfigEntry(const FString& modid, const TSharedRef<FJsonObject>& defaultValues, TArray<FConfigChange>& changes) {
+			FModConfigEntry* existingEntry = loadedConfigs.Find(modid);
+			if (existingEntry != nullptr) {
+				//defaults only need to be re-applied when they are not the same object as the last time
+				if (existingEntry->defaultValues != defaultValues) {
+					existingEntry->defaultValues = defaultValues;
+					if (setDefaultValues(existingEntry->json, defaultValues)) {
+						markConfigChanged(*existingEntry);
+						updateFlatValues(modid, *existingEntry, changes);
+					}
+				}
+				return *existingEntry;
+			}
+			FModConfigEntry& entry = loadedConfigs.Add(modid);
+			entry.filePath = getModConfigFilePath(modid);
+			entry.defaultValues = defaultValues;
+			loadConfigEntry(modid, entry);
+			flattenConfigValues(TEXT(""), entry.json, entry.flatValues);
+			return entry;
+		}
+
+		TSharedRef<FJsonObject> getModConfig(const FString& modid, const TSharedRef<FJsonObject>& defaultValues) {
+			TArray<FConfigChange> changes;
+			TSharedPtr<FJsonObject> result;
+			{
+				FScopeLock lock(&configRegistryLock);
+				result = findOrLoadConfigEntry(modid, defaultValues, changes).json;
+			}
+			notifySubscribers(changes);
+			return result.ToSharedRef();
+		}
+
+		void setModConfig(const FString& modid, const TSharedRef<FJsonObject>& config) {
+			TArray<FConfigChange> changes;
+			{
+				FScopeLock lock(&configRegistryLock);
+				FModConfigEntry* existingEntry = loadedConfigs.Find(modid);
+				if (existingEntry == nullptr) {
+					//config was never read, so written one is the best description of its defaults we have
+					existingEntry = &findOrLoadConfigEntry(modid, config, changes);
+				}
+				FModConfigEntry& entry = *existingEntry;
+				entry.json = config;
+				markConfigChanged(entry);
+				updateFlatValues(modid, entry, changes);
+			}
+			notifySubscribers(changes);
+		}
+
+		TSharedPtr<FJsonValue> getConfigValue(const FString& modid, const FString& key) {
+			FScopeLock lock(&configRegistryLock);
+			const FModConfigEntry* entry = loadedConfigs.Find(modid);
+			if (entry == nullptr) {
+				return nullptr;
+			}
+			const TSharedPtr<FJsonValue>* value = entry->flatValues.Find(key);
+			return value != nullptr ? *value : nullptr;
+		}
+
+		bool getConfigBool(const FString& modid, const FString& key, bool defaultValue) {
+			const TSharedPtr<FJsonValue> value = getConfigValue(modid, key);
+			bool result;
+			return value.IsValid() && value->TryGetBool(result) ? result : defaultValue;
+		}
+
+		double getConfigNumber(const FString& modid, const FString& key, double defaultValue) {
+			const TSharedPtr<FJsonValue> value = getConfigValue(modid, key);
+			double result;
+			return value.IsValid() && value->TryGetNumber(result) ? result : defaultValue;
+		}
+
+		FString getConfigString(const FString& modid, const FString& key, const FString& defaultValue) {
+			const TSharedPtr<FJsonValue> value = getConfigValue(modid, key);
+			FString result;
+			return value.IsValid() && value->TryGetString(result) ? result : defaultValue;
+		}
+
+		bool setConfigValue(const FString& modid, const FString& key, const TSharedRef<FJsonValue>& value) {
+			TArray<FConfigChange> changes;
+			{
+				FScopeLock lock(&configRegistryLock);
+				FModConfigEntry* entry = loadedConfigs.Find(modid);
+				if (entry == nullptr) {
+					return false;
+				}
+				TArray<FString> keyPath;
+				key.ParseIntoArray(keyPath, TEXT("."));
+				if (keyPath.Num() == 0) {
+					return false;
+				}
+				TSharedPtr<FJsonObject> object = entry->json;
+				for (int32 i = 0; i < keyPath.Num() - 1; i++) {
+					const TSharedPtr<FJsonValue>* childValue = object->Values.Find(keyPath[i]);
+					if (childValue == nullptr || !childValue->IsValid() || (*childValue)->Type != EJson::Object) {
+						TSharedRef<FJsonObject> childObject = MakeShareable(new FJsonObject());
+						object->SetObjectField(keyPath[i], childObject);
+						object = childObject;
+					} else {
+						object = (*childValue)->AsObject();
+					}
+				}
+				object->SetField(keyPath.Last(), value);
+				markConfigChanged(*entry);
+				updateFlatValues(modid, *entry, changes);
+			}
+			notifySubscribers(changes);
+			return true;
+		}
+
+		int32 subscribeToConfigKey(const FString& modid, const FString& key, const FConfigChangeCallback& callback) {
+			FScopeLock lock(&configRegistryLock);
+			const int32 subscriptionHandle = ++lastSubscriptionHandle;
+			configSubscriptions.Add(subscriptionHandle, FConfigSubscription{ modid, key, callback });
+			return subscriptionHandle;
+		}
+
+		void unsubscribeFromConfigKey(int32 subscriptionHandle) {
+			FScopeLock lock(&configRegistryLock);
+			configSubscriptions.Remove(subscriptionHandle);
+		}
+
+		void startConfigRegistry() {
+			FScopeLock lock(&configRegistryLock);
+			if (configRegistryStarted) {
+				return;
+			}
+			configRegistryStarted = true;
+			configTickerHandle = FTicker::GetCoreTicker().AddTicker(FTickerDelegate::CreateStatic(&tickConfigRegistry), configPollInterval);
+			FCoreDelegates::OnPreExit.AddStatic(&flushModConfigs);
+		}
+
+		void flushModConfigs() {
+			FScopeLock lock(&configRegistryLock);
+			for (auto& pair : loadedConfigs) {
+				if (pair.Value.hasPendingWrite) {
+					writeConfigEntry(pair.Value);
+				}
+			}
+		}
+	}
+}
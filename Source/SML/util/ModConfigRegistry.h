@@ -0,0 +1,63 @@
+#pragma once
+#include "CoreMinimal.h"
+#include "Json.h"
+#include <functional>
+
+namespace SML {
+	namespace Config {
+		/**
+		 * Called when value of the subscribed config key changes, either by the mod itself or
+		 * by the config file being edited on disk. newValue is invalid if key was removed
+		 */
+		typedef std::function<void(const FString& modid, const FString& key, const TSharedPtr<FJsonValue>& newValue)> FConfigChangeCallback;
+
+		/**
+		 * Returns cached config of the given mod, loading it and applying default values on first access
+		 * Returned object is shared with the registry, so use setModConfig to apply changes to it
+		 * Config file is only read again when it is modified on disk
+		 */
+		SML_API TSharedRef<FJsonObject> getModConfig(const FString& modid, const TSharedRef<FJsonObject>& defaultValues);
+
+		/**
+		 * Replaces config of the given mod, notifying subscribers of the changed keys
+		 * Config file is written once the config stops changing for a moment, or on exit
+		 */
+		SML_API void setModConfig(const FString& modid, const TSharedRef<FJsonObject>& config);
+
+		/**
+		 * Returns value of the given key of already loaded mod config, or invalid pointer if there is none
+		 * Nested object fields are accessed with dots, e.g. "spawning.maxCount"
+		 */
+		SML_API TSharedPtr<FJsonValue> getConfigValue(const FString& modid, const FString& key);
+
+		SML_API bool getConfigBool(const FString& modid, const FString& key, bool defaultValue = false);
+		SML_API double getConfigNumber(const FString& modid, const FString& key, double defaultValue = 0.0);
+		SML_API FString getConfigString(const FString& modid, const FString& key, const FString& defaultValue = TEXT(""));
+
+		/**
+		 * Sets value of the given key of already loaded mod config
+		 * Missing intermediate objects are created, returns false if config is not loaded
+		 */
+		SML_API bool setConfigValue(const FString& modid, const FString& key, const TSharedRef<FJsonValue>& value);
+
+		/**
+		 * Subscribes callback to the changes of the given config key, or to all keys of the mod if key is empty
+		 * Callbacks are always called on the game thread. Returns handle to pass into unsubscribeFromConfigKey
+		 */
+		SML_API int32 subscribeToConfigKey(const FString& modid, const FString& key, const FConfigChangeCallback& callback);
+
+		SML_API void unsubscribeFromConfigKey(int32 subscriptionHandle);
+
+		/**
+		 * Immediately writes all configs with pending changes to disk
+		 */
+		SML_API void flushModConfigs();
+
+		/**
+		 * Starts polling loaded config files for modifications and writing pending changes
+		 * Configs can be read before that (SML reads it's own one during bootstrap),
+		 * but ticker and timing are only available once engine is initialized, so SML calls it from post initialization
+		 */
+		void startConfigRegistry();
+	}
+}
@@ -0,0 +1,114 @@
+#include "StartupProfiler.h"
+#include "SatisfactoryModLoader.h"
+#include "util/Logging.h"
+#include "Json.h"
+#include <mutex>
+#include <thread>
+
+namespace SML {
+	namespace Profiling {
+		//name of the report files written into the config directory
+		static const TCHAR* startupReportFileName = TEXT("StartupReport");
+
+		struct FStartupSection {
+			FString name;
+			int32 parentIndex;
+			int32 depth;
+			double startSeconds;
+			double durationSeconds;
+		};
+
+		static std::mutex sectionsMutex;
+		static TArray<FStartupSection> recordedSections;
+		//time point all section start times are relative to, set by the first section
+		static std::chrono::steady_clock::time_point profilingStartTime;
+		//thread which opened the first section, normally the one running bootstrapSML
+		static std::thread::id bootstrapThreadId;
+		static bool profilingStarted = false;
+		//set once the startup report is written, no sections are recorded after that
+		static bool profilingFinished = false;
+		//stack of currently open sections on the bootstrap thread
+		static TArray<int32> bootstrapSectionStack;
+		//stack of currently open sections on the worker thread
+		static thread_local TArray<int32> workerSectionStack;
+
+		TArray<int32>& getSectionStack() {
+			return std::this_thread::get_id() == bootstrapThreadId ? bootstrapSectionStack : workerSectionStack;
+		}
+
+		FScopedStartupTimer::FScopedStartupTimer(const FString& sectionName) {
+			startTime = std::chrono::steady_clock::now();
+			std::lock_guard<std::mutex> lock(sectionsMutex);
+			if (profilingFinished) {
+				sectionIndex = INDEX_NONE;
+				return;
+			}
+			if (!profilingStarted) {
+				profilingStarted = true;
+				profilingStartTime = startTime;
+				bootstrapThreadId = std::this_thread::get_id();
+			}
+			TArray<int32>& sectionStack = getSectionStack();
+			int32 parentIndex = INDEX_NONE;
+			if (sectionStack.Num() > 0) {
+				parentIndex = sectionStack.Last();
+			} else if (bootstrapSectionStack.Num() > 0) {
+				parentIndex = bootstrapSectionStack.Last();
+			}
+			const int32 depth = parentIndex == INDEX_NONE ? 0 : recordedSections[parentIndex].depth + 1;
+			const double startSeconds = std::chrono::duration<double>(startTime - profilingStartTime).count();
+			sectionIndex = recordedSections.Add(FStartupSection{sectionName, parentIndex, depth, startSeconds, 0.0});
+			sectionStack.Push(sectionIndex);
+		}
+
+		FScopedStartupTimer::~FScopedStartupTimer() {
+			const double durationSeconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - startTime).count();
+			std::lock_guard<std::mutex> lock(sectionsMutex);
+			//sections still open when the report was written are not recorded anymore
+			if (sectionIndex == INDEX_NONE || profilingFinished) {
+				return;
+			}
+			recordedSections[sectionIndex].durationSeconds = durationSeconds;
+			getSectionStack().RemoveSingle(sectionIndex);
+		}
+
+		void writeStartupReport() {
+			TArray<FStartupSection> sections;
+			{
+				std::lock_guard<std::mutex> lock(sectionsMutex);
+				if (profilingFinished) {
+					return;
+				}
+				profilingFinished = true;
+				sections = MoveTemp(recordedSections);
+			}
+			TArray<TSharedPtr<FJsonValue>> sectionsJson;
+			TArray<FString> csvLines;
+			csvLines.Add(TEXT("Index,Parent,Depth,Name,StartMs,DurationMs"));
+			for (int32 i = 0; i < sections.Num(); i++) {
+				const FStartupSection& section = sections[i];
+				TSharedRef<FJsonObject> sectionJson = MakeShareable(new FJsonObject());
+				sectionJson->SetStringField(TEXT("Name"), section.name);
+				sectionJson->SetNumberField(TEXT("Parent"), section.parentIndex);
+				sectionJson->SetNumberField(TEXT("Depth"), section.depth);
+				sectionJson->SetNumberField(TEXT("StartMs"), section.startSeconds * 1000.0);
+				sectionJson->SetNumberField(TEXT("DurationMs"), section.durationSeconds * 1000.0);
+				sectionsJson.Add(MakeShareable(new FJsonValueObject(sectionJson)));
+				FString escapedName = section.name.Replace(TEXT("\""), TEXT("\"\""));
+				csvLines.Add(FString::Printf(TEXT("%d,%d,%d,\"%s\",%.3f,%.3f"), i, section.parentIndex, section.depth,
+					*escapedName, section.startSeconds * 1000.0, section.durationSeconds * 1000.0));
+			}
+			TSharedRef<FJsonObject> reportJson = MakeShareable(new FJsonObject());
+			reportJson->SetStringField(TEXT("SMLVersion"), getModLoaderVersion().string());
+			reportJson->SetArrayField(TEXT("Sections"), sectionsJson);
+
+			FString resultString;
+			TSharedRef<TJsonWriter<>> writer = TJsonWriterFactory<>::Create(&resultString);
+			FJsonSerializer::Serialize(reportJson, writer);
+			const FString reportPath = getConfigDirectory() / startupReportFileName;
+			FFileHelper::SaveStringToFile(resultString, *(reportPath + TEXT(".json")));
+			FFileHelper::SaveStringArrayToFile(csvLines, *(reportPath + TEXT(".csv")));
+			SML_LOG_DEBUG(SML::Logging::LogSML, TEXT("Written startup report with "), sections.Num(), TEXT(" sections"));
+		}
+	}
+}
@@ -0,0 +1,39 @@
+#pragma once
+#include "CoreMinimal.h"
+#include <chrono>
+
+namespace SML {
+	namespace Profiling {
+		/**
+		 * Measures time spent in the enclosing scope and records it as a section of the startup report
+		 * Sections opened while another section is active on the same thread become it's children
+		 * Sections opened on worker threads are attached to the section currently active on the bootstrap thread
+		 * Uses std::chrono instead of FPlatformTime because engine timing is not initialized during bootstrap
+		 */
+		class SML_API FScopedStartupTimer {
+		private:
+			int32 sectionIndex;
+			std::chrono::steady_clock::time_point startTime;
+		public:
+			FScopedStartupTimer(const FString& sectionName);
+			~FScopedStartupTimer();
+
+			FScopedStartupTimer(const FScopedStartupTimer&) = delete;
+			FScopedStartupTimer& operator=(const FScopedStartupTimer&) = delete;
+		};
+
+		/**
+		 * Writes all recorded startup sections into StartupReport.json and StartupReport.csv
+		 * inside of the config directory. SML calls it once mod actors of the first map are initialized,
+		 * so the report covers bootstrap, mod loading and the first mod actor initialization
+		 * Only the first call writes the report, recording stops after it, so later map loads
+		 * don't grow the section list or overwrite the startup report
+		 */
+		void writeStartupReport();
+	}
+}
+
+#define SML_STARTUP_TIMER_CONCAT_INNER(a, b) a##b
+#define SML_STARTUP_TIMER_CONCAT(a, b) SML_STARTUP_TIMER_CONCAT_INNER(a, b)
+/** Times the rest of the enclosing scope as a named startup report section */
+#define SML_STARTUP_TIMER(SectionName) SML::Profiling::FScopedStartupTimer SML_STARTUP_TIMER_CONCAT(startupTimer_, __LINE__)(SectionName)
@@ -0,0 +1,147 @@
+#include "TopologicalSort.h"
+
+using namespace SML::TopologicalSort;
+
+FCompressedGraph::FCompressedGraph(int32 nodeCount, const TArray<TPair<int32, int32>>& edges, bool reverse) {
+	//count edges per node first, then turn counts into row offsets
+	rowOffsets.SetNumZeroed(nodeCount + 1);
+	for (const TPair<int32, int32>& edge : edges) {
+		rowOffsets[(reverse ? edge.Value : edge.Key) + 1]++;
+	}
+	for (int32 i = 0; i < nodeCount; i++) {
+		rowOffsets[i + 1] += rowOffsets[i];
+	}
+	//scatter edge endpoints into their rows, preserving insertion order
+	TArray<int32> writeOffsets(rowOffsets.GetData(), nodeCount);
+	adjacency.SetNumUninitialized(edges.Num());
+	for (const TPair<int32, int32>& edge : edges) {
+		const int32 src = reverse ? edge.Value : edge.Key;
+		const int32 dest = reverse ? edge.Key : edge.Value;
+		adjacency[writeOffsets[src]++] = dest;
+	}
+}
+
+bool SML::TopologicalSort::sortLevels(const FCompressedGraph& graph, TArray<int32>& order, TArray<int32>& levelOffsets, TArray<int32>& cyclePath) {
+	const int32 nodeCount = graph.numNodes();
+	//build reversed graph from the forward one, so we can find nodes unlocked by the processed ones
+	TArray<TPair<int32, int32>> edges;
+	edges.Reserve(graph.adjacency.Num());
+	for (int32 node = 0; node < nodeCount; node++) {
+		for (int32 endpoint : graph.edgesFrom(node)) {
+			edges.Add(TPair<int32, int32>(node, endpoint));
+		}
+	}
+	const FCompressedGraph reversed(nodeCount, edges, true);
+	edges.Empty();
+
+	//amount of not yet processed endpoints for every node
+	TArray<int32> pendingEdges;
+	pendingEdges.SetNumUninitialized(nodeCount);
+	order.Reset(nodeCount);
+	levelOffsets.Reset();
+	levelOffsets.Add(0);
+	for (int32 node = 0; node < nodeCount; node++) {
+		pendingEdges[node] = graph.edgesFrom(node).Num();
+		if (pendingEdges[node] == 0) {
+			order.Add(node);
+		}
+	}
+	//process graph level by level, each level consisting of nodes unlocked by the previous one
+	int32 levelStart = 0;
+	while (levelStart < order.Num()) {
+		const int32 levelEnd = order.Num();
+		levelOffsets.Add(levelEnd);
+		for (int32 i = levelStart; i < levelEnd; i++) {
+			for (int32 dependent : reversed.edgesFrom(order[i])) {
+				if (--pendingEdges[dependent] == 0) {
+					order.Add(dependent);
+				}
+			}
+		}
+		//keep nodes in the level ordered by index so results do not depend on edge order
+		if (order.Num() > levelEnd) {
+			Sort(order.GetData() + levelEnd, order.Num() - levelEnd);
+		}
+		levelStart = levelEnd;
+	}
+	if (order.Num() == nodeCount) {
+		return true;
+	}
+
+	//every node left has at least one unprocessed endpoint, so walking them from any such node
+	//will eventually arrive at the node visited before, with the nodes in between forming a cycle
+	TArray<int32> pathPosition;
+	pathPosition.Init(INDEX_NONE, nodeCount);
+	TArray<int32> path;
+	int32 currentNode = 0;
+	while (pendingEdges[currentNode] == 0) {
+		currentNode++;
+	}
+	while (pathPosition[currentNode] == INDEX_NONE) {
+		pathPosition[currentNode] = path.Add(currentNode);
+		for (int32 endpoint : graph.edgesFrom(currentNode)) {
+			if (pendingEdges[endpoint] != 0) {
+				currentNode = endpoint;
+				break;
+			}
+		}
+	}
+	cyclePath.Reset();
+	cyclePath.Append(path.GetData() + pathPosition[currentNode], path.Num() - pathPosition[currentNode]);
+	return false;
+}
+
+bool SML::TopologicalSort::sortDependentsFirst(const FCompressedGraph& graph, TArray<int32>& order, TArray<int32>& cyclePath) {
+	const int32 nodeCount = graph.numNodes();
+	//reversed graph lists nodes having edges to the given one, ordered by their index
+	TArray<TPair<int32, int32>> edges;
+	edges.Reserve(graph.adjacency.Num());
+	for (int32 node = 0; node < nodeCount; node++) {
+		for (int32 endpoint : graph.edgesFrom(node)) {
+			edges.Add(TPair<int32, int32>(node, endpoint));
+		}
+	}
+	const FCompressedGraph reversed(nodeCount, edges, true);
+	edges.Empty();
+
+	enum class EVisitState : uint8 { NotVisited, Expanding, Expanded };
+	TArray<EVisitState> visitState;
+	visitState.Init(EVisitState::NotVisited, nodeCount);
+	//explicit depth-first search stack, holding node and position of the next reversed edge to explore
+	TArray<TPair<int32, int32>> stack;
+	order.Reset(nodeCount);
+	for (int32 rootNode = 0; rootNode < nodeCount; rootNode++) {
+		if (visitState[rootNode] != EVisitState::NotVisited) {
+			continue;
+		}
+		visitState[rootNode] = EVisitState::Expanding;
+		stack.Add(TPair<int32, int32>(rootNode, 0));
+		while (stack.Num() > 0) {
+			TPair<int32, int32>& top = stack.Last();
+			const TArrayView<const int32> dependents = reversed.edgesFrom(top.Key);
+			if (top.Value == dependents.Num()) {
+				//all nodes having edges to this one are placed, so it can be placed too
+				order.Add(top.Key);
+				visitState[top.Key] = EVisitState::Expanded;
+				stack.Pop(false);
+				continue;
+			}
+			const int32 dependent = dependents[top.Value++];
+			if (visitState[dependent] == EVisitState::Expanded) {
+				continue;
+			}
+			if (visitState[dependent] == EVisitState::Expanding) {
+				//stack walks edges backwards, so cycle in edge order is the stack tail reversed
+				cyclePath.Reset();
+				cyclePath.Add(dependent);
+				for (int32 i = stack.Num() - 1; stack[i].Key != dependent; i--) {
+					cyclePath.Add(stack[i].Key);
+				}
+				return false;
+			}
+			visitState[dependent] = EVisitState::Expanding;
+			stack.Add(TPair<int32, int32>(dependent, 0));
+		}
+	}
+	return true;
+}
@@ -1,6 +1,7 @@
 #pragma once
 
-#include "CoreTypes.h"
+#include "CoreMinimal.h"
+#include "Containers/ArrayView.h"
 #include <stdexcept>
 
 namespace SML {
@@ -8,35 +9,76 @@ namespace SML {
 
 		/**
 		* Thrown by topologicalSort when there is a cycle dependency detected in a given graph
+		* cyclePath holds every node of the cycle in edge order, cycleNode is the first one of them
 		*/
 		template<typename T>
 		class cycle_detected : public std::logic_error {
 		public:
 			typedef logic_error _Mybase;
 			const T cycleNode;
+			const TArray<T> cyclePath;
 
-			explicit cycle_detected(const char *message, const T cycleNode)
+			explicit cycle_detected(const char *message, const TArray<T>& cyclePath)
 				: _Mybase(message),
-				  cycleNode(cycleNode)
+				  cycleNode(cyclePath[0]),
+				  cyclePath(cyclePath)
 			{	// construct from message string
 			}
 		};
 
+		/**
+		* Immutable directed graph over dense node indices in compressed sparse row form
+		* Edges of node i are stored contiguously in adjacency[rowOffsets[i]..rowOffsets[i + 1])
+		*/
+		class SML_API FCompressedGraph {
+		public:
+			TArray<int32> rowOffsets;
+			TArray<int32> adjacency;
+		public:
+			/**
+			* Builds graph with given amount of nodes from the (src, dest) edge list
+			* Duplicate edges are kept as is
+			*/
+			FCompressedGraph(int32 nodeCount, const TArray<TPair<int32, int32>>& edges, bool reverse = false);
+
+			/** Returns amount of nodes in the graph */
+			FORCEINLINE int32 numNodes() const { return rowOffsets.Num() - 1; }
+
+			/** Returns indices of all nodes adjacent to the given one */
+			FORCEINLINE TArrayView<const int32> edgesFrom(int32 node) const {
+				return TArrayView<const int32>(adjacency.GetData() + rowOffsets[node], rowOffsets[node + 1] - rowOffsets[node]);
+			}
+		};
+
+		/**
+		* Sorts node indices of the graph so every node comes after all nodes adjacent to it
+		* Nodes are grouped into levels, level i occupying order[levelOffsets[i]..levelOffsets[i + 1])
+		* Nodes in the same level do not depend on each other, and are ordered by their index
+		* Returns false and fills cyclePath if graph contains a cycle
+		*/
+		SML_API bool sortLevels(const FCompressedGraph& graph, TArray<int32>& order, TArray<int32>& levelOffsets, TArray<int32>& cyclePath);
+
+		/**
+		* Sorts node indices of the graph so every node comes before all nodes adjacent to it
+		* Produces exactly the order of the recursive depth-first sort used before graphs were compressed:
+		* nodes are visited by index, and every node is placed once all nodes having edges to it are placed
+		* Returns false and fills cyclePath if graph contains a cycle
+		*/
+		SML_API bool sortDependentsFirst(const FCompressedGraph& graph, TArray<int32>& order, TArray<int32>& cyclePath);
+
 		/**
 		* Represents simple directional graph of some value type
-		* For memory efficiency, graph is represented via adjacent node list
+		* Values are mapped to dense indices in order of insertion, edges are stored
+		* as a flat list and compressed into FCompressedGraph when sorting
 		* Values passed into methods are copied internally
 		*/
 		template<typename T>
 		class DirectedGraph {
 		public:
-			//use a pointer to the unordered set as value to avoid excessive copying
-			TMap<T, TSet<T>*> nodes;
+			TMap<T, int32> nodeIndices;
+			TArray<T> nodeValues;
+			TArray<TPair<int32, int32>> edges;
 		public:
-			DirectedGraph();
-			DirectedGraph(const DirectedGraph<T>& src);
-			~DirectedGraph();
-
 			/**
 			* Adds node into the graph without any adjacent nodes
 			* returns false if specified node already exists in a graph
@@ -46,30 +88,41 @@ namespace SML {
 
 			/**
 			* Adds node adjacent to src into the graph
-			* If either of the nodes is not in a graph, throws std::invalid_argument
+			* returns false if either of the nodes is not in a graph
 			*/
 			bool addEdge(const T& src, const T& dest);
 
 			/**
-			* Returns all nodes adjacent to the given one
-			* Returned reference is valid as long as the this graph object is valid
-			* throws std::invalid_argument if specified node is not in a graph
+			* Returns amount of nodes in the graph
 			*/
-			const TSet<T>& edgesFrom(const T& node) const;
+			size_t size() const;
 
 			/**
-			* Returns amount of nodes in the graph
+			* Builds compressed representation of this graph, using node insertion indices
 			*/
-			size_t size() const;
+			FCompressedGraph compress() const;
 		};
 
 		/**
 		* Performs topological sort on the graph
-		* Returns a list of sorted elements
+		* Returns a list of sorted elements, every element placed before the elements it has edges to,
+		* so with edges pointing from dependent to dependency, dependents come first
+		* Mod load order depends on it, so the order must stay the same as in the recursive implementation
+		* throws cycle_detected if graph contains a cycle
 		*/
 		template<typename T>
 		TArray<T> topologicalSort(const DirectedGraph<T>& graph);
+
+		/**
+		* Performs topological sort on the graph, grouping elements into levels
+		* Elements of the same level only have edges to elements of previous levels,
+		* so they can be processed concurrently once previous levels are done
+		* NOTE: levels go in the opposite direction to topologicalSort, elements come after the ones they have edges to
+		* throws cycle_detected if graph contains a cycle
+		*/
+		template<typename T>
+		TArray<TArray<T>> topologicalLevels(const DirectedGraph<T>& graph);
 	};
 };
 
-#include "TopologicalSortImpl.h"
\ No newline at end of file
+#include "TopologicalSortImpl.h"
@@ -1,5 +1,6 @@
 #include "Utility.h"
 #include "util/Logging.h"
+#include "util/ModConfigRegistry.h"
 #include <regex>
 
 namespace SML {
@@ -18,35 +19,11 @@ namespace SML {
 	}
 	
 	TSharedRef<FJsonObject> readModConfig(FString modid, const TSharedRef<FJsonObject>& defaultValues) {
-		FString configPath = getModConfigFilePath(modid);
-		if (!FPaths::FileExists(configPath)) {
-			writeModConfig(modid, defaultValues);
-			return defaultValues;
-		}
-		
-		FString contents;
-		FFileHelper::LoadFileToString(contents, *configPath);
-
-		TSharedPtr<FJsonObject> loadedJson = parseJsonLenient(contents);
-		if (!loadedJson.IsValid()) {
-			writeModConfig(modid, defaultValues);
-			return defaultValues;
-		}
-		TSharedRef<FJsonObject> ref = loadedJson.ToSharedRef();
-		if (setDefaultValues(ref, defaultValues)) {
-			writeModConfig(modid, ref);
-		}
-		return ref;
+		return Config::getModConfig(modid, defaultValues);
 	}
 
 	void writeModConfig(FString modid, const TSharedRef<FJsonObject>& config) {
-		FString configPath = getModConfigFilePath(modid);
-
-		FString resultString;
-		TSharedRef<TJsonWriter<>> writer = TJsonWriterFactory<>::Create(&resultString);
-		FJsonSerializer Serializer;
-		Serializer.Serialize(config, writer);
-		FFileHelper::SaveStringToFile(resultString, *configPath);
+		Config::setModConfig(modid, config);
 	}
 
 	bool setDefaultValues(const TSharedPtr<FJsonObject>& j, const TSharedPtr<FJsonObject>& defaultValues) {
@@ -55,34 +32,32 @@ namespace SML {
 			const auto& key = it.Key;
 			const auto& value = it.Value;
 
+			TSharedPtr<FJsonValue>* jvalue = j->Values.Find(key);
 			// Add if not existing
-			if (!j->HasField(key)) {
+			if (jvalue == nullptr || !jvalue->IsValid()) {
 				j->SetField(key, value);
 				changedSomething = true;
 				continue;
 			}
 			// ignore type checks for key `$` (why tho?)
 			if (key.Len() != 1 || key[0] != '$') {
-				const auto& jvalue = j->Values[key];
 				// Override if wrong type
-				if (value->Type != jvalue->Type) {
-					j->SetField(key, value);
+				if (value->Type != (*jvalue)->Type) {
+					*jvalue = value;
 					changedSomething = true;
 					continue;
 				}
 			}
 			// iterate over sub object
 			if (value->Type == EJson::Object) {
-				changedSomething |= setDefaultValues(j->Values[key]->AsObject(), value->AsObject());
+				changedSomething |= setDefaultValues((*jvalue)->AsObject(), value->AsObject());
 			}
 		}
 
-		TArray<FString> configKeys;
-		j->Values.GetKeys(configKeys);
-		for (const FString& key : configKeys) {
-			// Remove if unused
-			if (!defaultValues->HasField(key)) {
-				j->RemoveField(key);
+		// Remove if unused
+		for (auto it = j->Values.CreateIterator(); it; ++it) {
+			if (!defaultValues->Values.Contains(it.Key())) {
+				it.RemoveCurrent();
 				changedSomething = true;
 			}
 		}
@@ -18,8 +18,9 @@ namespace SML {
 
 	/**
 	 * Parses mod configuration file and returns json object
-	 * returns json.null() if config file is missing, unreadable or corrupted
+	 * returns default values if config file is missing, unreadable or corrupted
 	 * It also supports comments in mod configs
+	 * Config is cached after the first call, see SML::Config::getModConfig
 	 */
 	SML_API TSharedRef<FJsonObject> readModConfig(FString modid, const TSharedRef<FJsonObject>& defaultValues);
 
@@ -1408,6 +1408,7 @@ struct ImGuiIO
     bool        ConfigWindowsResizeFromEdges;   // = true           // Enable resizing of windows from their edges and from the lower-left corner. This requires (io.BackendFlags & ImGuiBackendFlags_HasMouseCursors) because it needs mouse cursor feedback. (This used to be a per-window ImGuiWindowFlags_ResizeFromAnySide flag)
     bool        ConfigWindowsMoveFromTitleBarOnly; // = false       // [BETA] Set to true to only allow moving windows when clicked+dragged from the title bar. Windows without a title bar are not affected.
     float       ConfigWindowsMemoryCompactTimer;// = 60.0f          // [BETA] Compact window memory usage when unused. Set to -1.0f to disable.
+    int         ConfigStorageHashThreshold;     // = 256            // ImGuiStorage switches from sorted to hashed lookup once it holds that many keys. Set to 0 to always hash, -1 to never hash.
 
     //------------------------------------------------------------------
     // Platform Functions
@@ -1674,6 +1675,7 @@ struct ImGuiTextBuffer
 // Typically you don't have to worry about this since a storage is held within each Window.
 // We use it to e.g. store collapse state for a tree (Int 0/1)
 // This is optimized for efficient lookup (dichotomy into a contiguous buffer) and rare insertion (typically tied to user interactions aka max once a frame)
+// Storages growing above io.ConfigStorageHashThreshold keys switch to an open addressing hash index, so lookup and insertion stay O(1) with tens of thousands of keys.
 // You can use it as custom user storage for temporary values. Declare your own storage if, for example:
 // - You want to manipulate the open/close state of a particular sub-tree in your interface (tree node uses Int 0/1 to store their state).
 // - You want to store custom debug data easily without adding or editing structures in your code (probably not efficient, but convenient)
@@ -1690,12 +1692,13 @@ struct ImGuiStorage
         ImGuiStoragePair(ImGuiID _key, void* _val_p)    { key = _key; val_p = _val_p; }
     };
 
-    ImVector<ImGuiStoragePair>      Data;
+    ImVector<ImGuiStoragePair>      Data;       // Sorted by key, unless HashIndex is used, in which case pairs are in insertion order
+    ImVector<int>                   HashIndex;  // [Internal] Open addressing table of (index into Data + 1), 0 for empty slots. Empty while the storage is in sorted mode.
 
-    // - Get***() functions find pair, never add/allocate. Pairs are sorted so a query is O(log N)
+    // - Get***() functions find pair, never add/allocate. Pairs are sorted so a query is O(log N), or O(1) once hashed.
     // - Set***() functions find pair, insertion on demand if missing.
-    // - Sorted insertion is costly, paid once. A typical frame shouldn't need to insert any new pair.
-    void                Clear() { Data.clear(); }
+    // - Sorted insertion is costly, paid once. A typical frame shouldn't need to insert any new pair. Hashed insertion is O(1).
+    void                Clear() { Data.clear(); HashIndex.clear(); }
     IMGUI_API int       GetInt(ImGuiID key, int default_val = 0) const;
     IMGUI_API void      SetInt(ImGuiID key, int val);
     IMGUI_API bool      GetBool(ImGuiID key, bool default_val = false) const;
@@ -1718,6 +1721,7 @@ struct ImGuiStorage
     IMGUI_API void      SetAllInt(int val);
 
     // For quicker full rebuild of a storage (instead of an incremental one), you may add all your contents and then sort once.
+    // (This also rebuilds the hash index of a hashed storage, so it can be used the same way.)
     IMGUI_API void      BuildSortByKey();
 };
 
@@ -2108,7 +2112,8 @@ enum ImFontAtlasFlags_
 {
     ImFontAtlasFlags_None               = 0,
     ImFontAtlasFlags_NoPowerOfTwoHeight = 1 << 0,   // Don't round the height to next power of two
-    ImFontAtlasFlags_NoMouseCursors     = 1 << 1    // Don't build software mouse cursors into the atlas
+    ImFontAtlasFlags_NoMouseCursors     = 1 << 1,   // Don't build software mouse cursors into the atlas
+    ImFontAtlasFlags_NoTextLayoutCache  = 1 << 2    // Don't cache text layouts of the fonts (see ImFontTextLayoutCache)
 };
 
 // Load and rasterize multiple TTF/OTF fonts into a same texture. The font atlas will build a single texture holding:
@@ -2209,6 +2214,7 @@ struct ImFontAtlas
     ImVector<ImFontAtlasCustomRect> CustomRects;    // Rectangles for packing custom texture data into the atlas.
     ImVector<ImFontConfig>      ConfigData;         // Internal data
     int                         CustomRectIds[1];   // Identifiers of custom texture rectangle used by ImFontAtlas/ImDrawList
+    int                         TextLayoutFrameCount; // Advanced once per frame of the contexts sharing this atlas, ages ImFontTextLayoutCache of its fonts
 
 #ifndef IMGUI_DISABLE_OBSOLETE_FUNCTIONS
     typedef ImFontAtlasCustomRect    CustomRect;         // OBSOLETED in 1.72+
@@ -2216,6 +2222,39 @@ struct ImFontAtlas
 #endif
 };
 
+// [Internal] Cached layout of a single text run, see ImFontTextLayoutCache
+struct ImFontTextLayout
+{
+    ImGuiID                     Key;                // Hash of (size, wrap width, text)
+    float                       Size;
+    float                       WrapWidth;
+    int                         TextOffset;         // Copy of the text in ImFontTextLayoutCache::TextData, to tell hash collisions apart
+    int                         TextLength;
+    int                         VtxOffset;          // Glyph quads in ImFontTextLayoutCache::VtxData (4 vertices each), relative to the text position, col is unused
+    int                         VtxCount;
+    ImVec2                      TextSize;           // Result of CalcTextSizeA() with max_width = FLT_MAX
+    ImVec2                      QuadsMin, QuadsMax; // Bounding box of the glyph quads, relative to the text position
+    int                         LastFrameUsed;
+};
+
+// [Internal] Per-font cache of measured text sizes and pre-built glyph quads for word-wrapped text.
+// Texts which don't change from frame to frame are laid out once, after which CalcTextSizeA() is a lookup and RenderText() only copies vertices,
+// as long as the whole text is inside the clipping rectangle. Entries not used for a while are discarded by NewFrame(),
+// which ImGui::NewFrame() calls for the fonts of io.Fonts once per ImFontAtlas::TextLayoutFrameCount, so contexts sharing an atlas
+// don't age the cache faster than frames go by. Disable with ImFontAtlasFlags_NoTextLayoutCache.
+struct ImFontTextLayoutCache
+{
+    ImVector<ImFontTextLayout>  Layouts;
+    ImVector<char>              TextData;
+    ImVector<ImDrawVert>        VtxData;
+    ImGuiStorage                Map;                // Key -> index into Layouts + 1
+    int                         FrameCount;
+
+    ImFontTextLayoutCache()     { FrameCount = 0; }
+    void                        Clear() { Layouts.clear(); TextData.clear(); VtxData.clear(); Map.Clear(); }
+    IMGUI_API void              NewFrame();
+};
+
 // Font runtime data and rendering
 // ImFontAtlas automatically loads a default embedded font for you when you call GetTexDataAsAlpha8() or GetTexDataAsRGBA32().
 struct ImFont
@@ -2241,6 +2280,7 @@ struct ImFont
     float                       Scale;              // 4     // in  // = 1.f      // Base font scale, multiplied by the per-window font scale which you can adjust with SetWindowFontScale()
     float                       Ascent, Descent;    // 4+4   // out //            // Ascent: distance from top to bottom of e.g. 'A' [0..FontSize]
     int                         MetricsTotalSurface;// 4     // out //            // Total surface in pixels to get an idea of the font rasterization/texture cost (not exact, we approximate the cost of padding between glyphs)
+    mutable ImFontTextLayoutCache LayoutCache;      //       // out //            // Layouts of recently measured/rendered texts, filled by CalcTextSizeA() and RenderText()
 
     // Methods
     IMGUI_API ImFont();
@@ -2265,6 +2305,8 @@ struct ImFont
     IMGUI_API void              AddGlyph(ImWchar c, float x0, float y0, float x1, float y1, float u0, float v0, float u1, float v1, float advance_x);
     IMGUI_API void              AddRemapChar(ImWchar dst, ImWchar src, bool overwrite_dst = true); // Makes 'dst' character/glyph points to 'src' character/glyph. Currently needs to be called AFTER fonts have been built.
     IMGUI_API void              SetFallbackChar(ImWchar c);
+    IMGUI_API ImVec2            CalcTextSizeNoCacheA(float size, float max_width, float wrap_width, const char* text_begin, const char* text_end, const char** remaining) const;
+    IMGUI_API const ImFontTextLayout* FindOrBuildTextLayout(float size, float wrap_width, const char* text_begin, const char* text_end) const; // NULL if the text can't be cached
 };
 
 #if defined(__clang__)
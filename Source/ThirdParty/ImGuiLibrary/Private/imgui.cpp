@@ -1062,6 +1062,7 @@ ImGuiIO::ImGuiIO()
     ConfigWindowsResizeFromEdges = true;
     ConfigWindowsMoveFromTitleBarOnly = false;
     ConfigWindowsMemoryCompactTimer = 60.0f;
+    ConfigStorageHashThreshold = 256;
 
     // Platform Functions
     BackendPlatformName = BackendRendererName = NULL;
@@ -1427,17 +1428,56 @@ static const ImU32 GCrc32LookupTable[256] =
     0xBDBDF21C,0xCABAC28A,0x53B39330,0x24B4A3A6,0xBAD03605,0xCDD70693,0x54DE5729,0x23D967BF,0xB3667A2E,0xC4614AB8,0x5D681B02,0x2A6F2B94,0xB40BBE37,0xC30C8EA1,0x5A05DF1B,0x2D02EF8D,
 };
 
-// Known size hash
-// It is ok to call ImHashData on a string with known length but the ### operator won't be supported.
-// FIXME-OPT: Replace with e.g. FNV1a hash? CRC32 pretty much randomly access 1KB. Need to do proper measurements.
-ImU32 ImHashData(const void* data_p, size_t data_size, ImU32 seed)
+// Slicing-by-8 tables derived from GCrc32LookupTable (Table[0] is the same table).
+// They let us consume 8 bytes per iteration with independent lookups instead of one dependent lookup per byte, while producing the exact same CRC32.
+// (We can't use the SSE4.2 crc32 instruction: it computes CRC32-C, a different polynomial, which would change every ID stored in .ini files.)
+// The tables are built on first use from a function-local static, which is thread-safe and keeps ImHashXXX functions usable by static constructors.
+struct ImCrc32SliceTables
 {
-    ImU32 crc = ~seed;
-    const unsigned char* data = (const unsigned char*)data_p;
+    ImU32 Table[8][256];
+    ImCrc32SliceTables()
+    {
+        for (int n = 0; n < 256; n++)
+            Table[0][n] = GCrc32LookupTable[n];
+        for (int k = 1; k < 8; k++)
+            for (int n = 0; n < 256; n++)
+                Table[k][n] = (Table[k - 1][n] >> 8) ^ Table[0][Table[k - 1][n] & 0xFF];
+    }
+};
+
+static const ImCrc32SliceTables& GetCrc32SliceTables()
+{
+    static const ImCrc32SliceTables tables;
+    return tables;
+}
+
+// Update a (non-inverted) CRC32 with data_size bytes. Short inputs, which are the majority of IDs, use the 1KB table only.
+static ImU32 ImCrc32Update(ImU32 crc, const unsigned char* data, size_t data_size)
+{
+    if (data_size >= 16)
+    {
+        const ImU32 (*t)[256] = GetCrc32SliceTables().Table;
+        while (data_size >= 8)
+        {
+            const ImU32 lo = crc ^ ((ImU32)data[0] | ((ImU32)data[1] << 8) | ((ImU32)data[2] << 16) | ((ImU32)data[3] << 24));
+            const ImU32 hi = (ImU32)data[4] | ((ImU32)data[5] << 8) | ((ImU32)data[6] << 16) | ((ImU32)data[7] << 24);
+            crc = t[7][lo & 0xFF] ^ t[6][(lo >> 8) & 0xFF] ^ t[5][(lo >> 16) & 0xFF] ^ t[4][lo >> 24] ^
+                  t[3][hi & 0xFF] ^ t[2][(hi >> 8) & 0xFF] ^ t[1][(hi >> 16) & 0xFF] ^ t[0][hi >> 24];
+            data += 8;
+            data_size -= 8;
+        }
+    }
     const ImU32* crc32_lut = GCrc32LookupTable;
     while (data_size-- != 0)
         crc = (crc >> 8) ^ crc32_lut[(crc & 0xFF) ^ *data++];
-    return ~crc;
+    return crc;
+}
+
+// Known size hash
+// It is ok to call ImHashData on a string with known length but the ### operator won't be supported.
+ImU32 ImHashData(const void* data_p, size_t data_size, ImU32 seed)
+{
+    return ~ImCrc32Update(~seed, (const unsigned char*)data_p, data_size);
 }
 
 // Zero-terminated string hash, with support for ### to reset back to seed value
@@ -1445,7 +1485,8 @@ ImU32 ImHashData(const void* data_p, size_t data_size, ImU32 seed)
 // Because this syntax is rarely used we are optimizing for the common case.
 // - If we reach ### in the string we discard the hash so far and reset to the seed.
 // - We don't do 'current += 2; continue;' after handling ### to keep the code smaller/faster (measured ~10% diff in Debug build)
-// FIXME-OPT: Replace with e.g. FNV1a hash? CRC32 pretty much randomly access 1KB. Need to do proper measurements.
+// - Most IDs are short, so the first 16 bytes are hashed one at a time. For the remainder, only the part starting at the last ###
+//   contributes to the hash, so we locate it with memchr() (vectorized by the C runtime) and hash it with ImCrc32Update().
 ImU32 ImHashStr(const char* data_p, size_t data_size, ImU32 seed)
 {
     seed = ~seed;
@@ -1454,8 +1495,10 @@ ImU32 ImHashStr(const char* data_p, size_t data_size, ImU32 seed)
     const ImU32* crc32_lut = GCrc32LookupTable;
     if (data_size != 0)
     {
-        while (data_size-- != 0)
+        const unsigned char* head_end = data + (data_size < 16 ? data_size : 16);
+        while (data < head_end)
         {
+            data_size--;
             unsigned char c = *data++;
             if (c == '#' && data_size >= 2 && data[0] == '#' && data[1] == '#')
                 crc = seed;
@@ -1464,14 +1507,32 @@ ImU32 ImHashStr(const char* data_p, size_t data_size, ImU32 seed)
     }
     else
     {
-        while (unsigned char c = *data++)
+        const unsigned char* head_end = data + 16;
+        while (data < head_end)
         {
+            unsigned char c = *data++;
+            if (c == 0)
+                return ~crc;
             if (c == '#' && data[0] == '#' && data[1] == '#')
                 crc = seed;
             crc = (crc >> 8) ^ crc32_lut[(crc & 0xFF) ^ c];
         }
+        data_size = strlen((const char*)data);
     }
-    return ~crc;
+
+    const unsigned char* data_end = data + data_size;
+    for (const unsigned char* p = data; data_end - p >= 3; p++)
+    {
+        p = (const unsigned char*)memchr(p, '#', (size_t)(data_end - p - 2));
+        if (p == NULL)
+            break;
+        if (p[1] == '#' && p[2] == '#')
+        {
+            crc = seed;
+            data = p;
+        }
+    }
+    return ~ImCrc32Update(crc, data, (size_t)(data_end - data));
 }
 
 //-----------------------------------------------------------------------------
@@ -1831,6 +1892,75 @@ static ImGuiStorage::ImGuiStoragePair* LowerBound(ImVector<ImGuiStorage::ImGuiSt
     return first;
 }
 
+// Keys are usually already hashes, but not necessarily well distributed in the low bits (e.g. user provided indices), so mix them.
+static inline int StorageHashSlot(ImGuiID key, int mask)
+{
+    ImU32 h = key * 0x9E3779B1u;
+    return (int)((h ^ (h >> 15)) & (ImU32)mask);
+}
+
+static void StorageHashIndexAdd(ImGuiStorage& storage, int data_idx)
+{
+    const int mask = storage.HashIndex.Size - 1;
+    int slot = StorageHashSlot(storage.Data.Data[data_idx].key, mask);
+    while (storage.HashIndex.Data[slot] != 0)
+        slot = (slot + 1) & mask;
+    storage.HashIndex.Data[slot] = data_idx + 1;
+}
+
+// Size the table for a load factor of at most 1/4, it gets rebuilt once the load factor goes over 1/2
+static void StorageRebuildHashIndex(ImGuiStorage& storage)
+{
+    int size = 64;
+    while (size < storage.Data.Size * 4)
+        size <<= 1;
+    storage.HashIndex.resize(size);
+    memset(storage.HashIndex.Data, 0, (size_t)size * sizeof(int));
+    for (int n = 0; n < storage.Data.Size; n++)
+        StorageHashIndexAdd(storage, n);
+}
+
+// Return the pair for 'key', or NULL if missing. In sorted mode, also output the position where a pair with that key should be inserted.
+static ImGuiStorage::ImGuiStoragePair* StorageFindPair(ImGuiStorage& storage, ImGuiID key, ImGuiStorage::ImGuiStoragePair** out_insert_it = NULL)
+{
+    if (storage.HashIndex.Size > 0)
+    {
+        const int mask = storage.HashIndex.Size - 1;
+        for (int slot = StorageHashSlot(key, mask); storage.HashIndex.Data[slot] != 0; slot = (slot + 1) & mask)
+        {
+            ImGuiStorage::ImGuiStoragePair* pair = &storage.Data.Data[storage.HashIndex.Data[slot] - 1];
+            if (pair->key == key)
+                return pair;
+        }
+        if (out_insert_it)
+            *out_insert_it = storage.Data.end();
+        return NULL;
+    }
+    ImGuiStorage::ImGuiStoragePair* it = LowerBound(storage.Data, key);
+    if (out_insert_it)
+        *out_insert_it = it;
+    if (it == storage.Data.end() || it->key != key)
+        return NULL;
+    return it;
+}
+
+// Sorted storages switch to hashed mode once they grow above io.ConfigStorageHashThreshold. Storages used without a context use the default threshold.
+static ImGuiStorage::ImGuiStoragePair* StorageInsertPair(ImGuiStorage& storage, ImGuiStorage::ImGuiStoragePair* insert_it, const ImGuiStorage::ImGuiStoragePair& pair)
+{
+    if (storage.HashIndex.Size == 0)
+    {
+        const int threshold = GImGui ? GImGui->IO.ConfigStorageHashThreshold : 256;
+        if (threshold < 0 || storage.Data.Size + 1 < threshold)
+            return storage.Data.insert(insert_it, pair);
+    }
+    storage.Data.push_back(pair);
+    if (storage.HashIndex.Size == 0 || storage.Data.Size * 2 > storage.HashIndex.Size)
+        StorageRebuildHashIndex(storage);
+    else
+        StorageHashIndexAdd(storage, storage.Data.Size - 1);
+    return &storage.Data.back();
+}
+
 // For quicker full rebuild of a storage (instead of an incremental one), you may add all your contents and then sort once.
 void ImGuiStorage::BuildSortByKey()
 {
@@ -1846,14 +1976,14 @@ void ImGuiStorage::BuildSortByKey()
     };
     if (Data.Size > 1)
         ImQsort(Data.Data, (size_t)Data.Size, sizeof(ImGuiStoragePair), StaticFunc::PairCompareByID);
+    if (HashIndex.Size > 0)
+        StorageRebuildHashIndex(*this);
 }
 
 int ImGuiStorage::GetInt(ImGuiID key, int default_val) const
 {
-    ImGuiStoragePair* it = LowerBound(const_cast<ImVector<ImGuiStoragePair>&>(Data), key);
-    if (it == Data.end() || it->key != key)
-        return default_val;
-    return it->val_i;
+    ImGuiStoragePair* it = StorageFindPair(const_cast<ImGuiStorage&>(*this), key);
+    return it ? it->val_i : default_val;
 }
 
 bool ImGuiStorage::GetBool(ImGuiID key, bool default_val) const
@@ -1863,26 +1993,23 @@ bool ImGuiStorage::GetBool(ImGuiID key, bool default_val) const
 
 float ImGuiStorage::GetFloat(ImGuiID key, float default_val) const
 {
-    ImGuiStoragePair* it = LowerBound(const_cast<ImVector<ImGuiStoragePair>&>(Data), key);
-    if (it == Data.end() || it->key != key)
-        return default_val;
-    return it->val_f;
+    ImGuiStoragePair* it = StorageFindPair(const_cast<ImGuiStorage&>(*this), key);
+    return it ? it->val_f : default_val;
 }
 
 void* ImGuiStorage::GetVoidPtr(ImGuiID key) const
 {
-    ImGuiStoragePair* it = LowerBound(const_cast<ImVector<ImGuiStoragePair>&>(Data), key);
-    if (it == Data.end() || it->key != key)
-        return NULL;
-    return it->val_p;
+    ImGuiStoragePair* it = StorageFindPair(const_cast<ImGuiStorage&>(*this), key);
+    return it ? it->val_p : NULL;
 }
 
 // References are only valid until a new value is added to the storage. Calling a Set***() function or a Get***Ref() function invalidates the pointer.
 int* ImGuiStorage::GetIntRef(ImGuiID key, int default_val)
 {
-    ImGuiStoragePair* it = LowerBound(Data, key);
-    if (it == Data.end() || it->key != key)
-        it = Data.insert(it, ImGuiStoragePair(key, default_val));
+    ImGuiStoragePair* insert_it;
+    ImGuiStoragePair* it = StorageFindPair(*this, key, &insert_it);
+    if (it == NULL)
+        it = StorageInsertPair(*this, insert_it, ImGuiStoragePair(key, default_val));
     return &it->val_i;
 }
 
@@ -1893,30 +2020,30 @@ bool* ImGuiStorage::GetBoolRef(ImGuiID key, bool default_val)
 
 float* ImGuiStorage::GetFloatRef(ImGuiID key, float default_val)
 {
-    ImGuiStoragePair* it = LowerBound(Data, key);
-    if (it == Data.end() || it->key != key)
-        it = Data.insert(it, ImGuiStoragePair(key, default_val));
+    ImGuiStoragePair* insert_it;
+    ImGuiStoragePair* it = StorageFindPair(*this, key, &insert_it);
+    if (it == NULL)
+        it = StorageInsertPair(*this, insert_it, ImGuiStoragePair(key, default_val));
     return &it->val_f;
 }
 
 void** ImGuiStorage::GetVoidPtrRef(ImGuiID key, void* default_val)
 {
-    ImGuiStoragePair* it = LowerBound(Data, key);
-    if (it == Data.end() || it->key != key)
-        it = Data.insert(it, ImGuiStoragePair(key, default_val));
+    ImGuiStoragePair* insert_it;
+    ImGuiStoragePair* it = StorageFindPair(*this, key, &insert_it);
+    if (it == NULL)
+        it = StorageInsertPair(*this, insert_it, ImGuiStoragePair(key, default_val));
     return &it->val_p;
 }
 
 // FIXME-OPT: Need a way to reuse the result of lower_bound when doing GetInt()/SetInt() - not too bad because it only happens on explicit interaction (maximum one a frame)
 void ImGuiStorage::SetInt(ImGuiID key, int val)
 {
-    ImGuiStoragePair* it = LowerBound(Data, key);
-    if (it == Data.end() || it->key != key)
-    {
-        Data.insert(it, ImGuiStoragePair(key, val));
-        return;
-    }
-    it->val_i = val;
+    ImGuiStoragePair* insert_it;
+    if (ImGuiStoragePair* it = StorageFindPair(*this, key, &insert_it))
+        it->val_i = val;
+    else
+        StorageInsertPair(*this, insert_it, ImGuiStoragePair(key, val));
 }
 
 void ImGuiStorage::SetBool(ImGuiID key, bool val)
@@ -1926,24 +2053,20 @@ void ImGuiStorage::SetBool(ImGuiID key, bool val)
 
 void ImGuiStorage::SetFloat(ImGuiID key, float val)
 {
-    ImGuiStoragePair* it = LowerBound(Data, key);
-    if (it == Data.end() || it->key != key)
-    {
-        Data.insert(it, ImGuiStoragePair(key, val));
-        return;
-    }
-    it->val_f = val;
+    ImGuiStoragePair* insert_it;
+    if (ImGuiStoragePair* it = StorageFindPair(*this, key, &insert_it))
+        it->val_f = val;
+    else
+        StorageInsertPair(*this, insert_it, ImGuiStoragePair(key, val));
 }
 
 void ImGuiStorage::SetVoidPtr(ImGuiID key, void* val)
 {
-    ImGuiStoragePair* it = LowerBound(Data, key);
-    if (it == Data.end() || it->key != key)
-    {
-        Data.insert(it, ImGuiStoragePair(key, val));
-        return;
-    }
-    it->val_p = val;
+    ImGuiStoragePair* insert_it;
+    if (ImGuiStoragePair* it = StorageFindPair(*this, key, &insert_it))
+        it->val_p = val;
+    else
+        StorageInsertPair(*this, insert_it, ImGuiStoragePair(key, val));
 }
 
 void ImGuiStorage::SetAllInt(int v)
@@ -3623,6 +3746,16 @@ void ImGui::NewFrame()
 
     // Setup current font and draw list shared data
     g.IO.Fonts->Locked = true;
+    // The atlas can be shared by multiple contexts, each calling NewFrame() once per application frame. The atlas frame is only advanced
+    // by a context which has already seen the current one, so text layout caches age once per application frame, not once per context.
+    ImFontAtlas* atlas = g.IO.Fonts;
+    if (g.FontAtlasFrameCountSeen == atlas->TextLayoutFrameCount)
+    {
+        atlas->TextLayoutFrameCount++;
+        for (int n = 0; n < atlas->Fonts.Size; n++)
+            atlas->Fonts[n]->LayoutCache.NewFrame();
+    }
+    g.FontAtlasFrameCountSeen = atlas->TextLayoutFrameCount;
     SetCurrentFont(GetDefaultFont());
     IM_ASSERT(g.Font->IsLoaded());
     g.DrawListSharedData.ClipRectFullscreen = ImVec4(0.0f, 0.0f, g.IO.DisplaySize.x, g.IO.DisplaySize.y);
@@ -15,6 +15,7 @@ Index of this file:
 // [SECTION] ImFontAtlas
 // [SECTION] ImFontAtlas glyph ranges helpers
 // [SECTION] ImFontGlyphRangesBuilder
+// [SECTION] ImFontTextLayoutCache
 // [SECTION] ImFont
 // [SECTION] Internal Render Helpers
 // [SECTION] Decompression code
@@ -1595,6 +1596,7 @@ ImFontAtlas::ImFontAtlas()
     TexUvWhitePixel = ImVec2(0.0f, 0.0f);
     for (int n = 0; n < IM_ARRAYSIZE(CustomRectIds); n++)
         CustomRectIds[n] = -1;
+    TextLayoutFrameCount = 0;
 }
 
 ImFontAtlas::~ImFontAtlas()
@@ -2575,6 +2577,225 @@ void ImFontGlyphRangesBuilder::BuildRanges(ImVector<ImWchar>* out_ranges)
     out_ranges->push_back(0);
 }
 
+//-----------------------------------------------------------------------------
+// [SECTION] ImFontTextLayoutCache
+//-----------------------------------------------------------------------------
+
+static const int FONT_TEXT_LAYOUT_MIN_TEXT_LENGTH = 4;      // Shorter texts are cheaper to lay out than to look up
+static const int FONT_TEXT_LAYOUT_MAX_TEXT_LENGTH = 1024;
+static const int FONT_TEXT_LAYOUT_MAX_COUNT = 16384;
+static const int FONT_TEXT_LAYOUT_GC_INTERVAL = 60;         // In frames
+static const int FONT_TEXT_LAYOUT_KEEP_FRAMES = 120;        // Layouts not used for that many frames are discarded
+
+// Discard layouts which haven't been used recently. When the cache is full, only keep layouts used during the last frame.
+// Kept layouts are compacted in place, so this doesn't allocate.
+void ImFontTextLayoutCache::NewFrame()
+{
+    FrameCount++;
+    const bool is_full = (Layouts.Size >= FONT_TEXT_LAYOUT_MAX_COUNT);
+    if ((FrameCount % FONT_TEXT_LAYOUT_GC_INTERVAL) != 0 && !is_full)
+        return;
+
+    const int min_frame_used = FrameCount - (is_full ? 1 : FONT_TEXT_LAYOUT_KEEP_FRAMES);
+    int discard_count = 0;
+    for (int n = 0; n < Layouts.Size; n++)
+        if (Layouts[n].LastFrameUsed < min_frame_used)
+            discard_count++;
+    if (discard_count == 0)
+        return;
+
+    int layouts_count = 0;
+    int text_data_size = 0;
+    int vtx_data_size = 0;
+    Map.Clear();
+    for (int n = 0; n < Layouts.Size; n++)
+    {
+        ImFontTextLayout layout = Layouts[n];
+        if (layout.LastFrameUsed < min_frame_used)
+            continue;
+        memmove(TextData.Data + text_data_size, TextData.Data + layout.TextOffset, (size_t)layout.TextLength);
+        layout.TextOffset = text_data_size;
+        text_data_size += layout.TextLength;
+        memmove(VtxData.Data + vtx_data_size, VtxData.Data + layout.VtxOffset, (size_t)layout.VtxCount * sizeof(ImDrawVert));
+        layout.VtxOffset = vtx_data_size;
+        vtx_data_size += layout.VtxCount;
+        Layouts[layouts_count++] = layout;
+        Map.SetInt(layout.Key, layouts_count);
+    }
+    Layouts.resize(layouts_count);
+    TextData.resize(text_data_size);
+    VtxData.resize(vtx_data_size);
+}
+
+// Same layout as ImFont::RenderText() with an infinite clipping rectangle, relative to the text position
+static void BuildTextLayoutVertices(const ImFont* font, float size, float wrap_width, const char* s, const char* text_end, ImVector<ImDrawVert>& out_vtx, ImVec2* out_quads_min, ImVec2* out_quads_max)
+{
+    const float scale = size / font->FontSize;
+    const float line_height = font->FontSize * scale;
+    const bool word_wrap_enabled = (wrap_width > 0.0f);
+    const char* word_wrap_eol = NULL;
+    float x = 0.0f;
+    float y = 0.0f;
+    ImVec2 quads_min(FLT_MAX, FLT_MAX);
+    ImVec2 quads_max(-FLT_MAX, -FLT_MAX);
+
+    while (s < text_end)
+    {
+        if (word_wrap_enabled)
+        {
+            if (!word_wrap_eol)
+            {
+                word_wrap_eol = font->CalcWordWrapPositionA(scale, s, text_end, wrap_width - x);
+                if (word_wrap_eol == s)
+                    word_wrap_eol++;
+            }
+
+            if (s >= word_wrap_eol)
+            {
+                x = 0.0f;
+                y += line_height;
+                word_wrap_eol = NULL;
+
+                // Wrapping skips upcoming blanks
+                while (s < text_end)
+                {
+                    const char c = *s;
+                    if (ImCharIsBlankA(c)) { s++; } else if (c == '\n') { s++; break; } else { break; }
+                }
+                continue;
+            }
+        }
+
+        // Decode and advance source
+        unsigned int c = (unsigned int)*s;
+        if (c < 0x80)
+        {
+            s += 1;
+        }
+        else
+        {
+            s += ImTextCharFromUtf8(&c, s, text_end);
+            if (c == 0) // Malformed UTF-8?
+                break;
+        }
+
+        if (c < 32)
+        {
+            if (c == '\n')
+            {
+                x = 0.0f;
+                y += line_height;
+                continue;
+            }
+            if (c == '\r')
+                continue;
+        }
+
+        float char_width = 0.0f;
+        if (const ImFontGlyph* glyph = font->FindGlyph((ImWchar)c))
+        {
+            char_width = glyph->AdvanceX * scale;
+            if (c != ' ' && c != '\t')
+            {
+                const float x1 = x + glyph->X0 * scale;
+                const float x2 = x + glyph->X1 * scale;
+                const float y1 = y + glyph->Y0 * scale;
+                const float y2 = y + glyph->Y1 * scale;
+                out_vtx.resize(out_vtx.Size + 4);
+                ImDrawVert* vtx = &out_vtx.Data[out_vtx.Size - 4];
+                vtx[0].pos.x = x1; vtx[0].pos.y = y1; vtx[0].col = 0; vtx[0].uv.x = glyph->U0; vtx[0].uv.y = glyph->V0;
+                vtx[1].pos.x = x2; vtx[1].pos.y = y1; vtx[1].col = 0; vtx[1].uv.x = glyph->U1; vtx[1].uv.y = glyph->V0;
+                vtx[2].pos.x = x2; vtx[2].pos.y = y2; vtx[2].col = 0; vtx[2].uv.x = glyph->U1; vtx[2].uv.y = glyph->V1;
+                vtx[3].pos.x = x1; vtx[3].pos.y = y2; vtx[3].col = 0; vtx[3].uv.x = glyph->U0; vtx[3].uv.y = glyph->V1;
+                quads_min = ImMin(quads_min, ImVec2(x1, y1));
+                quads_max = ImMax(quads_max, ImVec2(x2, y2));
+            }
+        }
+
+        x += char_width;
+    }
+
+    if (quads_min.x > quads_max.x)
+        quads_min = quads_max = ImVec2(0.0f, 0.0f);
+    *out_quads_min = quads_min;
+    *out_quads_max = quads_max;
+}
+
+static void RenderTextLayout(ImDrawList* draw_list, const ImFontTextLayoutCache& cache, const ImFontTextLayout& layout, ImVec2 pos, ImU32 col)
+{
+    const int vtx_count = layout.VtxCount;
+    if (vtx_count == 0)
+        return;
+    const int idx_count = (vtx_count / 4) * 6;
+    draw_list->PrimReserve(idx_count, vtx_count);
+
+    ImDrawVert* vtx_write = draw_list->_VtxWritePtr;
+    ImDrawIdx* idx_write = draw_list->_IdxWritePtr;
+    unsigned int vtx_current_idx = draw_list->_VtxCurrentIdx;
+    const ImDrawVert* vtx_read = cache.VtxData.Data + layout.VtxOffset;
+    for (int n = 0; n < vtx_count; n += 4)
+    {
+        idx_write[0] = (ImDrawIdx)(vtx_current_idx); idx_write[1] = (ImDrawIdx)(vtx_current_idx+1); idx_write[2] = (ImDrawIdx)(vtx_current_idx+2);
+        idx_write[3] = (ImDrawIdx)(vtx_current_idx); idx_write[4] = (ImDrawIdx)(vtx_current_idx+2); idx_write[5] = (ImDrawIdx)(vtx_current_idx+3);
+        for (int k = 0; k < 4; k++)
+        {
+            vtx_write[k].pos.x = vtx_read[k].pos.x + pos.x; vtx_write[k].pos.y = vtx_read[k].pos.y + pos.y;
+            vtx_write[k].uv = vtx_read[k].uv; vtx_write[k].col = col;
+        }
+        vtx_read += 4;
+        vtx_write += 4;
+        vtx_current_idx += 4;
+        idx_write += 6;
+    }
+    draw_list->_VtxWritePtr = vtx_write;
+    draw_list->_IdxWritePtr = idx_write;
+    draw_list->_VtxCurrentIdx = vtx_current_idx;
+}
+
+const ImFontTextLayout* ImFont::FindOrBuildTextLayout(float size, float wrap_width, const char* text_begin, const char* text_end) const
+{
+    // Only word-wrapped text is cached: the single line glyph loop is bound by writing vertices, and is as fast as copying cached ones.
+    // Word wrapping scans the text twice and calls CalcWordWrapPositionA() for every line, which is what the cache saves us.
+    const int text_length = (int)(text_end - text_begin);
+    if (wrap_width <= 0.0f || text_length < FONT_TEXT_LAYOUT_MIN_TEXT_LENGTH || text_length > FONT_TEXT_LAYOUT_MAX_TEXT_LENGTH || DirtyLookupTables)
+        return NULL;
+    if (ContainerAtlas == NULL || (ContainerAtlas->Flags & ImFontAtlasFlags_NoTextLayoutCache))
+        return NULL;
+
+    ImFontTextLayoutCache& cache = LayoutCache;
+    ImGuiID key = ImHashData(&size, sizeof(size));
+    key = ImHashData(&wrap_width, sizeof(wrap_width), key);
+    key = ImHashData(text_begin, (size_t)text_length, key);
+    const int layout_idx = cache.Map.GetInt(key, 0) - 1;
+    if (layout_idx >= 0)
+    {
+        ImFontTextLayout& layout = cache.Layouts[layout_idx];
+        if (layout.Size != size || layout.WrapWidth != wrap_width || layout.TextLength != text_length || memcmp(cache.TextData.Data + layout.TextOffset, text_begin, (size_t)text_length) != 0)
+            return NULL; // Hash collision: keep the existing layout and let the caller use the uncached path
+        layout.LastFrameUsed = cache.FrameCount;
+        return &layout;
+    }
+    if (cache.Layouts.Size >= FONT_TEXT_LAYOUT_MAX_COUNT)
+        return NULL;
+
+    ImFontTextLayout layout;
+    layout.Key = key;
+    layout.Size = size;
+    layout.WrapWidth = wrap_width;
+    layout.TextOffset = cache.TextData.Size;
+    layout.TextLength = text_length;
+    cache.TextData.resize(cache.TextData.Size + text_length);
+    memcpy(cache.TextData.Data + layout.TextOffset, text_begin, (size_t)text_length);
+    layout.TextSize = CalcTextSizeNoCacheA(size, FLT_MAX, wrap_width, text_begin, text_end, NULL);
+    layout.VtxOffset = cache.VtxData.Size;
+    BuildTextLayoutVertices(this, size, wrap_width, text_begin, text_end, cache.VtxData, &layout.QuadsMin, &layout.QuadsMax);
+    layout.VtxCount = cache.VtxData.Size - layout.VtxOffset;
+    layout.LastFrameUsed = cache.FrameCount;
+    cache.Layouts.push_back(layout);
+    cache.Map.SetInt(key, cache.Layouts.Size);
+    return &cache.Layouts.back();
+}
+
 //-----------------------------------------------------------------------------
 // [SECTION] ImFont
 //-----------------------------------------------------------------------------
@@ -2613,6 +2834,7 @@ void    ImFont::ClearOutputData()
     DirtyLookupTables = true;
     Ascent = Descent = 0.0f;
     MetricsTotalSurface = 0;
+    LayoutCache.Clear();
 }
 
 void ImFont::BuildLookupTable()
@@ -2625,6 +2847,7 @@ void ImFont::BuildLookupTable()
     IndexAdvanceX.clear();
     IndexLookup.clear();
     DirtyLookupTables = false;
+    LayoutCache.Clear();
     GrowIndex(max_codepoint + 1);
     for (int i = 0; i < Glyphs.Size; i++)
     {
@@ -2707,6 +2930,7 @@ void ImFont::AddRemapChar(ImWchar dst, ImWchar src, bool overwrite_dst)
     GrowIndex(dst + 1);
     IndexLookup[dst] = (src < index_size) ? IndexLookup.Data[src] : (ImWchar)-1;
     IndexAdvanceX[dst] = (src < index_size) ? IndexAdvanceX.Data[src] : 1.0f;
+    LayoutCache.Clear();
 }
 
 const ImFontGlyph* ImFont::FindGlyph(ImWchar c) const
@@ -2833,6 +3057,17 @@ ImVec2 ImFont::CalcTextSizeA(float size, float max_width, float wrap_width, cons
     if (!text_end)
         text_end = text_begin + strlen(text_begin); // FIXME-OPT: Need to avoid this.
 
+    if (max_width == FLT_MAX && remaining == NULL)
+        if (const ImFontTextLayout* layout = FindOrBuildTextLayout(size, wrap_width, text_begin, text_end))
+            return layout->TextSize;
+    return CalcTextSizeNoCacheA(size, max_width, wrap_width, text_begin, text_end, remaining);
+}
+
+ImVec2 ImFont::CalcTextSizeNoCacheA(float size, float max_width, float wrap_width, const char* text_begin, const char* text_end, const char** remaining) const
+{
+    if (!text_end)
+        text_end = text_begin + strlen(text_begin);
+
     const float line_height = size;
     const float scale = size / FontSize;
 
@@ -2949,6 +3184,17 @@ void ImFont::RenderText(ImDrawList* draw_list, float size, ImVec2 pos, ImU32 col
     if (y > clip_rect.w)
         return;
 
+    // Fully visible text doesn't need any clipping, so we can replay its cached glyph quads
+    if (const ImFontTextLayout* layout = FindOrBuildTextLayout(size, wrap_width, text_begin, text_end))
+    {
+        if (y >= clip_rect.y && y + ImMax(layout->TextSize.y, layout->QuadsMax.y) <= clip_rect.w && y + layout->QuadsMin.y >= clip_rect.y &&
+            x + layout->QuadsMin.x >= clip_rect.x && x + layout->QuadsMax.x <= clip_rect.z)
+        {
+            RenderTextLayout(draw_list, LayoutCache, *layout, pos, col);
+            return;
+        }
+    }
+
     const float scale = size / FontSize;
     const float line_height = FontSize * scale;
     const bool word_wrap_enabled = (wrap_width > 0.0f);
@@ -0,0 +1,191 @@
+/*
+ * ImGuiHashParity - checks that ImHashStr and ImHashData in Source/ThirdParty/ImGuiLibrary produce exactly
+ * the same hashes as the byte-wise CRC32 implementation ImGui used before, and measures their throughput
+ * Window, table and docking IDs stored in imgui .ini files are made of these hashes, so they must never change
+ *
+ * It only depends on the C++ standard library and the ImGui library sources, build it with:
+ *   g++ -std=c++14 -O2 -I../../Source/ThirdParty/ImGuiLibrary/Include -I../../Source/ThirdParty/ImGuiLibrary/Private
+ *       -o imguihashparity ImGuiHashParity.cpp ../../Source/ThirdParty/ImGuiLibrary/Private/imgui*.cpp
+ *   cl /std:c++14 /O2 /EHsc /I..\..\Source\ThirdParty\ImGuiLibrary\Include /I..\..\Source\ThirdParty\ImGuiLibrary\Private
+ *       ImGuiHashParity.cpp ..\..\Source\ThirdParty\ImGuiLibrary\Private\imgui*.cpp
+ *
+ * Usage: imguihashparity [iterations] [seed] [--bench]
+ * Exits with non-zero status and prints the offending inputs if hashes differ
+ */
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+#include "imgui.h"
+#include "imgui_internal.h"
+
+//reference CRC32 table, generated from the polynomial instead of copied, so a damaged table in imgui.cpp is caught
+static ImU32 referenceTable[256];
+
+static void initReferenceTable() {
+	for (ImU32 n = 0; n < 256; n++) {
+		ImU32 crc = n;
+		for (int bit = 0; bit < 8; bit++) {
+			crc = (crc & 1) ? (crc >> 1) ^ 0xEDB88320u : crc >> 1;
+		}
+		referenceTable[n] = crc;
+	}
+}
+
+//byte-wise implementations ImGui used before slicing-by-8, copied verbatim apart from the table name
+static ImU32 referenceHashData(const void* data_p, size_t data_size, ImU32 seed) {
+	ImU32 crc = ~seed;
+	const unsigned char* data = (const unsigned char*)data_p;
+	while (data_size-- != 0)
+		crc = (crc >> 8) ^ referenceTable[(crc & 0xFF) ^ *data++];
+	return ~crc;
+}
+
+static ImU32 referenceHashStr(const char* data_p, size_t data_size, ImU32 seed) {
+	seed = ~seed;
+	ImU32 crc = seed;
+	const unsigned char* data = (const unsigned char*)data_p;
+	if (data_size != 0) {
+		while (data_size-- != 0) {
+			unsigned char c = *data++;
+			if (c == '#' && data_size >= 2 && data[0] == '#' && data[1] == '#')
+				crc = seed;
+			crc = (crc >> 8) ^ referenceTable[(crc & 0xFF) ^ c];
+		}
+	} else {
+		while (unsigned char c = *data++) {
+			if (c == '#' && data[0] == '#' && data[1] == '#')
+				crc = seed;
+			crc = (crc >> 8) ^ referenceTable[(crc & 0xFF) ^ c];
+		}
+	}
+	return ~crc;
+}
+
+struct KnownHash {
+	const char* string;
+	ImU32 seed;
+	ImU32 hash;
+};
+
+//fixed hashes of IDs ImGui writes into .ini files, they catch reference and library changing together
+//plain strings without ### are standard CRC32 values, e.g. zlib.crc32(b"Window") == 0x8C48FCEB
+static const KnownHash knownHashes[] = {
+	{"Window", 0, 0x8C48FCEBu},
+	{"Table", 0, 0x37E8A042u},
+	{"Debug##Default", 0, 0x9F5F46A1u},
+	{"#RESIZE", 0, 0x527D9478u},
+	{"Label###StableId", 0, 0xDCB3B63Du},
+	{"", 0, 0x00000000u},
+	{"Window", 0x12345678u, 0xBC8151C4u},
+};
+
+//random strings are built mostly from '#' and a few letters, so "###" appears at every position, including the tails
+static std::string generateString(std::mt19937_64& random, size_t maxLength) {
+	static const char alphabet[] = "####abc#XYZ 01##";
+	const size_t length = random() % (maxLength + 1);
+	std::string result(length, ' ');
+	const bool hashHeavy = random() % 2 == 0;
+	for (size_t i = 0; i < length; i++) {
+		result[i] = hashHeavy ? alphabet[random() % (sizeof(alphabet) - 1)] : static_cast<char>(1 + random() % 255);
+	}
+	return result;
+}
+
+static int runParity(uint64_t iterations, uint64_t seed) {
+	std::mt19937_64 random(seed);
+	uint64_t mismatches = 0;
+	const auto report = [&mismatches](const char* function, const std::string& input, size_t length, ImU32 seedValue, ImU32 expected, ImU32 actual) {
+		if (mismatches++ < 20) {
+			std::cout << "Mismatch in " << function << " on " << input.size() << " byte input (length argument " << length
+				<< ", seed 0x" << std::hex << seedValue << "): expected 0x" << expected << ", got 0x" << actual << std::dec << std::endl;
+		}
+	};
+	for (const KnownHash& known : knownHashes) {
+		const ImU32 referenceHash = referenceHashStr(known.string, 0, known.seed);
+		const ImU32 actualHash = ImHashStr(known.string, 0, known.seed);
+		if (referenceHash != known.hash || actualHash != known.hash) {
+			std::cout << "Known hash of \"" << known.string << "\" changed: expected 0x" << std::hex << known.hash
+				<< ", reference 0x" << referenceHash << ", library 0x" << actualHash << std::dec << std::endl;
+			mismatches++;
+		}
+	}
+	//inputs are placed at random offsets of a padded buffer, so unaligned starts and ends are covered
+	std::vector<char> buffer(2048 + 16);
+	for (uint64_t i = 0; i < iterations; i++) {
+		const size_t maxLength = i % 4 == 0 ? 1024 : 64;
+		const std::string input = generateString(random, maxLength);
+		const ImU32 seedValue = random() % 4 == 0 ? static_cast<ImU32>(random()) : 0;
+		char* start = buffer.data() + random() % 16;
+		std::memcpy(start, input.data(), input.size());
+		start[input.size()] = '\0';
+
+		ImU32 expected = referenceHashData(start, input.size(), seedValue);
+		ImU32 actual = ImHashData(start, input.size(), seedValue);
+		if (expected != actual) report("ImHashData", input, input.size(), seedValue, expected, actual);
+
+		if (!input.empty()) {
+			expected = referenceHashStr(start, input.size(), seedValue);
+			actual = ImHashStr(start, input.size(), seedValue);
+			if (expected != actual) report("ImHashStr", input, input.size(), seedValue, expected, actual);
+		}
+		//zero terminated form stops at the first zero byte, which random binary strings can contain
+		expected = referenceHashStr(start, 0, seedValue);
+		actual = ImHashStr(start, 0, seedValue);
+		if (expected != actual) report("ImHashStr", input, 0, seedValue, expected, actual);
+	}
+	std::cout << "Checked " << iterations << " random inputs with seed " << seed << ", " << mismatches << " mismatches" << std::endl;
+	return mismatches == 0 ? 0 : 1;
+}
+
+template<typename FuncType>
+static double measureNanosPerCall(FuncType&& func, uint64_t calls) {
+	const auto startTime = std::chrono::steady_clock::now();
+	for (uint64_t i = 0; i < calls; i++) {
+		func();
+	}
+	return std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - startTime).count() / calls;
+}
+
+static void runBenchmark() {
+	static const size_t lengths[] = {8, 15, 16, 24, 32, 64, 128, 1024};
+	volatile ImU32 sink = 0;
+	for (const size_t length : lengths) {
+		//label-like strings without ###, the common case
+		const std::string input(length, 'a');
+		const uint64_t calls = 200000000 / (length + 16);
+		const double referenceStr = measureNanosPerCall([&]() { sink = sink + referenceHashStr(input.c_str(), 0, sink); }, calls);
+		const double libraryStr = measureNanosPerCall([&]() { sink = sink + ImHashStr(input.c_str(), 0, sink); }, calls);
+		const double referenceData = measureNanosPerCall([&]() { sink = sink + referenceHashData(input.data(), length, sink); }, calls);
+		const double libraryData = measureNanosPerCall([&]() { sink = sink + ImHashData(input.data(), length, sink); }, calls);
+		std::printf("%5zu bytes: ImHashStr %7.2f ns (byte-wise %7.2f ns, %.2fx), ImHashData %7.2f ns (byte-wise %7.2f ns, %.2fx)\n",
+			length, libraryStr, referenceStr, referenceStr / libraryStr, libraryData, referenceData, referenceData / libraryData);
+	}
+}
+
+int main(int argc, char** argv) {
+	uint64_t iterations = 1000000;
+	uint64_t seed = 20240301;
+	bool benchmark = false;
+	int positional = 0;
+	for (int i = 1; i < argc; i++) {
+		if (std::strcmp(argv[i], "--bench") == 0) {
+			benchmark = true;
+		} else if (positional++ == 0) {
+			iterations = std::strtoull(argv[i], nullptr, 10);
+		} else {
+			seed = std::strtoull(argv[i], nullptr, 10);
+		}
+	}
+	initReferenceTable();
+	const int result = runParity(iterations, seed);
+	if (benchmark) {
+		runBenchmark();
+	}
+	return result;
+}
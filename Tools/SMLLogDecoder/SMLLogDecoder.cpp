@@ -0,0 +1,300 @@
+/*
+ * SMLLogDecoder - renders structured binary SML logs (SatisfactoryModLoader.smllog)
+ * as plain text, in the same format as SatisfactoryModLoader.log, or as JSON lines
+ * File format is described in Source/SML/util/BinaryLog.h
+ *
+ * It has no dependencies besides the C++ standard library, build it with:
+ *   g++ -std=c++14 -O2 -o smllogdecoder SMLLogDecoder.cpp
+ *   cl /std:c++14 /O2 /EHsc SMLLogDecoder.cpp
+ *
+ * Usage: smllogdecoder [--json] [--timestamps] <file.smllog>
+ */
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <ctime>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+static const uint8_t FormatVersion = 2;
+//oldest format version which can still be decoded, version 1 has no Dropped records
+static const uint8_t MinFormatVersion = 1;
+
+enum RecordKind : uint8_t {
+	StringDefinition = 1,
+	Entry = 2,
+	Dropped = 3
+};
+
+enum ArgumentTag : uint8_t {
+	End = 0,
+	StringRef = 1,
+	StringInline = 2,
+	Signed = 3,
+	Unsigned = 4,
+	Double = 5
+};
+
+static const char* levelNames[] = {"DEBUG", "INFO", "WARN", "ERROR", "FATAL"};
+
+class Reader {
+public:
+	explicit Reader(const char* path) : stream(path, std::ios::binary) {
+		if (!stream.is_open()) {
+			throw std::runtime_error(std::string("cannot open ") + path);
+		}
+	}
+
+	bool atEnd() {
+		return stream.peek() == std::char_traits<char>::eof();
+	}
+
+	uint8_t readByte() {
+		const int value = stream.get();
+		if (value == std::char_traits<char>::eof()) {
+			throw std::runtime_error("unexpected end of file");
+		}
+		return static_cast<uint8_t>(value);
+	}
+
+	uint64_t readVarInt() {
+		uint64_t result = 0;
+		for (int shift = 0; shift < 64; shift += 7) {
+			const uint8_t byte = readByte();
+			result |= static_cast<uint64_t>(byte & 0x7F) << shift;
+			if ((byte & 0x80) == 0) {
+				return result;
+			}
+		}
+		throw std::runtime_error("malformed varint");
+	}
+
+	std::string readString() {
+		const uint64_t length = readVarInt();
+		std::string result(length, '\0');
+		readBytes(&result[0], length);
+		return result;
+	}
+
+	void readBytes(void* destination, size_t length) {
+		if (length > 0 && !stream.read(static_cast<char*>(destination), length)) {
+			throw std::runtime_error("unexpected end of file");
+		}
+	}
+
+	void rewind(std::streamoff offset) {
+		stream.clear();
+		stream.seekg(offset);
+	}
+
+	std::streamoff position() {
+		return stream.tellg();
+	}
+
+private:
+	std::ifstream stream;
+};
+
+struct FileHeader {
+	int64_t startTimeMillis;
+};
+
+static FileHeader readHeader(Reader& reader) {
+	char magic[4];
+	reader.readBytes(magic, 4);
+	if (std::memcmp(magic, "SMLB", 4) != 0) {
+		throw std::runtime_error("not a binary SML log file");
+	}
+	const uint8_t version = reader.readByte();
+	if (version < MinFormatVersion || version > FormatVersion) {
+		throw std::runtime_error("unsupported binary log format version " + std::to_string(version));
+	}
+	uint8_t timeBytes[8];
+	reader.readBytes(timeBytes, 8);
+	uint64_t startTime = 0;
+	for (int i = 0; i < 8; i++) {
+		startTime |= static_cast<uint64_t>(timeBytes[i]) << (i * 8);
+	}
+	return FileHeader{static_cast<int64_t>(startTime)};
+}
+
+//skips over the entry arguments, used by the first pass which only collects string definitions
+static void skipEntry(Reader& reader) {
+	reader.readVarInt();
+	reader.readByte();
+	while (true) {
+		switch (reader.readByte()) {
+		case End: return;
+		case StringRef: reader.readVarInt(); break;
+		case StringInline: reader.readString(); break;
+		case Signed: reader.readVarInt(); break;
+		case Unsigned: reader.readVarInt(); break;
+		case Double: { char skipped[8]; reader.readBytes(skipped, 8); break; }
+		default: throw std::runtime_error("unknown argument tag");
+		}
+	}
+}
+
+//string definitions can appear after entries referencing them when multiple threads were logging,
+//so all of them are collected before rendering any entry
+static std::unordered_map<uint64_t, std::string> collectStrings(Reader& reader) {
+	std::unordered_map<uint64_t, std::string> strings;
+	while (!reader.atEnd()) {
+		const uint8_t kind = reader.readByte();
+		if (kind == StringDefinition) {
+			const uint64_t id = reader.readVarInt();
+			strings[id] = reader.readString();
+		} else if (kind == Entry) {
+			skipEntry(reader);
+		} else if (kind == Dropped) {
+			reader.readVarInt();
+			reader.readVarInt();
+		} else {
+			throw std::runtime_error("unknown record kind");
+		}
+	}
+	return strings;
+}
+
+static std::string escapeJson(const std::string& value) {
+	std::string result;
+	result.reserve(value.size() + 2);
+	for (const char character : value) {
+		switch (character) {
+		case '"': result += "\\\""; break;
+		case '\\': result += "\\\\"; break;
+		case '\n': result += "\\n"; break;
+		case '\r': result += "\\r"; break;
+		case '\t': result += "\\t"; break;
+		default:
+			if (static_cast<unsigned char>(character) < 0x20) {
+				char escaped[8];
+				std::snprintf(escaped, sizeof(escaped), "\\u%04x", character);
+				result += escaped;
+			} else {
+				result += character;
+			}
+		}
+	}
+	return result;
+}
+
+static std::string formatTimestamp(int64_t unixMillis) {
+	const std::time_t seconds = static_cast<std::time_t>(unixMillis / 1000);
+	std::tm time{};
+#ifdef _WIN32
+	gmtime_s(&time, &seconds);
+#else
+	gmtime_r(&seconds, &time);
+#endif
+	char buffer[40];
+	std::strftime(buffer, sizeof(buffer), "%Y-%m-%dT%H:%M:%S", &time);
+	char result[48];
+	std::snprintf(result, sizeof(result), "%s.%03dZ", buffer, static_cast<int>(unixMillis % 1000));
+	return result;
+}
+
+static void renderEntries(Reader& reader, const FileHeader& header, const std::unordered_map<uint64_t, std::string>& strings, bool json, bool timestamps) {
+	while (!reader.atEnd()) {
+		const uint8_t kind = reader.readByte();
+		if (kind == StringDefinition) {
+			reader.readVarInt();
+			reader.readString();
+			continue;
+		}
+		if (kind == Dropped) {
+			const uint64_t timeMicros = reader.readVarInt();
+			const uint64_t droppedEntries = reader.readVarInt();
+			const int64_t entryTimeMillis = header.startTimeMillis + static_cast<int64_t>(timeMicros / 1000);
+			if (json) {
+				std::cout << "{\"time\":\"" << formatTimestamp(entryTimeMillis) << "\",\"elapsedUs\":" << timeMicros
+					<< ",\"dropped\":" << droppedEntries << "}\n";
+			} else {
+				if (timestamps) {
+					std::cout << '[' << formatTimestamp(entryTimeMillis) << "] ";
+				}
+				std::cout << "[WARN] Binary log queue overflow, dropped " << droppedEntries << " entries\n";
+			}
+			continue;
+		}
+		if (kind != Entry) {
+			throw std::runtime_error("unknown record kind");
+		}
+		const uint64_t timeMicros = reader.readVarInt();
+		const uint8_t level = reader.readByte();
+		std::ostringstream message;
+		bool finished = false;
+		while (!finished) {
+			switch (reader.readByte()) {
+			case End: finished = true; break;
+			case StringRef: {
+				const auto it = strings.find(reader.readVarInt());
+				message << (it != strings.end() ? it->second : std::string("<missing string>"));
+				break;
+			}
+			case StringInline: message << reader.readString(); break;
+			case Signed: {
+				const uint64_t encoded = reader.readVarInt();
+				message << static_cast<int64_t>((encoded >> 1) ^ (~(encoded & 1) + 1));
+				break;
+			}
+			case Unsigned: message << reader.readVarInt(); break;
+			case Double: {
+				double value;
+				reader.readBytes(&value, sizeof(value));
+				message << value;
+				break;
+			}
+			default: throw std::runtime_error("unknown argument tag");
+			}
+		}
+		const char* levelName = level < sizeof(levelNames) / sizeof(levelNames[0]) ? levelNames[level] : "UNKNOWN";
+		const int64_t entryTimeMillis = header.startTimeMillis + static_cast<int64_t>(timeMicros / 1000);
+		if (json) {
+			std::cout << "{\"time\":\"" << formatTimestamp(entryTimeMillis) << "\",\"elapsedUs\":" << timeMicros
+				<< ",\"level\":\"" << levelName << "\",\"message\":\"" << escapeJson(message.str()) << "\"}\n";
+		} else {
+			if (timestamps) {
+				std::cout << '[' << formatTimestamp(entryTimeMillis) << "] ";
+			}
+			std::cout << '[' << levelName << "] " << message.str() << '\n';
+		}
+	}
+}
+
+int main(int argc, char** argv) {
+	bool json = false;
+	bool timestamps = false;
+	const char* filePath = nullptr;
+	for (int i = 1; i < argc; i++) {
+		if (std::strcmp(argv[i], "--json") == 0) {
+			json = true;
+		} else if (std::strcmp(argv[i], "--timestamps") == 0) {
+			timestamps = true;
+		} else {
+			filePath = argv[i];
+		}
+	}
+	if (filePath == nullptr) {
+		std::cerr << "Usage: " << argv[0] << " [--json] [--timestamps] <file.smllog>" << std::endl;
+		return 2;
+	}
+	try {
+		Reader reader(filePath);
+		const FileHeader header = readHeader(reader);
+		const std::streamoff recordsStart = reader.position();
+		const std::unordered_map<uint64_t, std::string> strings = collectStrings(reader);
+		reader.rewind(recordsStart);
+		renderEntries(reader, header, strings, json, timestamps);
+	} catch (const std::exception& ex) {
+		std::cout.flush();
+		std::cerr << "Failed to decode " << filePath << ": " << ex.what() << std::endl;
+		return 1;
+	}
+	return 0;
+}
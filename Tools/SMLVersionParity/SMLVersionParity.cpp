@@ -0,0 +1,167 @@
+/*
+ * SMLVersionParity - checks that the version parser in Source/SML/mod/VersionParser.h accepts and decodes
+ * exactly the same version strings as the std::wregex based parser SML used before it, on a fixed corpus
+ * and on randomly generated strings, so version syntax accepted by mods can't change silently
+ *
+ * It has no dependencies besides the C++ standard library, build it with:
+ *   g++ -std=c++14 -O2 -I../../Source/SML -o smlversionparity SMLVersionParity.cpp
+ *   cl /std:c++14 /O2 /EHsc /I..\..\Source\SML SMLVersionParity.cpp
+ *
+ * Usage: smlversionparity [iterations] [seed]
+ * Exits with non-zero status and prints the offending strings if parsers disagree
+ */
+#include <cstdint>
+#include <cstdlib>
+#include <iostream>
+#include <random>
+#include <regex>
+#include <stdexcept>
+#include <string>
+#include <vector>
+#include "mod/VersionParser.h"
+
+using namespace SML::Versioning;
+
+//pattern of the regex parser used before, copied verbatim
+static const std::wregex versionRegex(L"^(<=|<|>|>=|\\^)?(0|[1-9]\\d*)\\.(0|[1-9]\\d*)\\.(0|[1-9]\\d*)(?:-((?:0|[1-9]\\d*|\\d*[a-zA-Z-][0-9a-zA-Z-]*)(?:\\.(?:0|[1-9]\\d*|\\d*[a-zA-Z-][0-9a-zA-Z-]*))*))?(?:\\+([0-9a-zA-Z-]+(?:\\.[0-9a-zA-Z-]+)*))?$", std::regex::ECMAScript | std::regex::optimize);
+
+struct VersionResult {
+	bool valid;
+	EComparisonOp op;
+	uint64_t major;
+	uint64_t minor;
+	uint64_t patch;
+	std::wstring type;
+	std::wstring buildInfo;
+};
+
+static EComparisonOp comparisonOpFromString(const std::wstring& op) {
+	if (op == L"<=") return EComparisonOp::LESS_EQUALS;
+	if (op == L"<") return EComparisonOp::LESS;
+	if (op == L">=") return EComparisonOp::GREATER_EQUALS;
+	if (op == L">") return EComparisonOp::GREATER;
+	return EComparisonOp::EQUALS;
+}
+
+static VersionResult parseWithRegex(const std::wstring& string) {
+	VersionResult result{};
+	std::wsmatch match;
+	if (!std::regex_match(string, match, versionRegex)) {
+		return result;
+	}
+	try {
+		result.major = std::stoull(match[2]);
+		result.minor = std::stoull(match[3]);
+		result.patch = std::stoull(match[4]);
+	} catch (const std::out_of_range&) {
+		//regex parser threw on numbers not fitting into 64 bits, new parser rejects them
+		return result;
+	}
+	result.valid = true;
+	result.op = comparisonOpFromString(match[1].str());
+	result.type = match[5].str();
+	result.buildInfo = match[6].str();
+	return result;
+}
+
+static VersionResult parseWithParser(const std::wstring& string) {
+	VersionResult result{};
+	Parser::FParsedVersion parsed;
+	if (!Parser::parseVersion(string.data(), static_cast<int32_t>(string.size()), parsed)) {
+		return result;
+	}
+	result.valid = true;
+	result.op = parsed.op;
+	result.major = parsed.major;
+	result.minor = parsed.minor;
+	result.patch = parsed.patch;
+	result.type = string.substr(parsed.typeStart, parsed.typeLength);
+	result.buildInfo = string.substr(parsed.buildInfoStart, parsed.buildInfoLength);
+	return result;
+}
+
+static bool resultsEqual(const VersionResult& a, const VersionResult& b) {
+	if (a.valid != b.valid) return false;
+	if (!a.valid) return true;
+	return a.op == b.op && a.major == b.major && a.minor == b.minor && a.patch == b.patch &&
+		a.type == b.type && a.buildInfo == b.buildInfo;
+}
+
+//random strings are built from version-like fragments, so most of them are close to valid versions
+static std::wstring generateVersionString(std::mt19937_64& random) {
+	static const std::vector<std::wstring> prefixes = {L"", L"", L"", L"<", L"<=", L">", L">=", L"^", L"=", L"~", L" "};
+	static const std::vector<std::wstring> numbers = {L"0", L"1", L"2", L"10", L"00", L"01", L"123", L"",
+		L"18446744073709551615", L"18446744073709551616", L"99999999999999999999", L"a"};
+	static const std::vector<std::wstring> identifiers = {L"alpha", L"beta", L"rc", L"0", L"1", L"01", L"00", L"0a",
+		L"a0", L"-", L"--", L"x-y", L"", L"A", L"Z9", L"build", L"é", L"_", L" "};
+	auto pick = [&random](const std::vector<std::wstring>& values) -> const std::wstring& {
+		return values[random() % values.size()];
+	};
+	std::wstring result = pick(prefixes);
+	result += pick(numbers);
+	for (int i = 0; i < 2; i++) {
+		if (random() % 20 != 0) result += L'.';
+		result += pick(numbers);
+	}
+	for (const wchar_t separator : {L'-', L'+'}) {
+		if (random() % 3 == 0) {
+			result += separator;
+			const int count = 1 + static_cast<int>(random() % 3);
+			for (int i = 0; i < count; i++) {
+				if (i > 0) result += L'.';
+				result += pick(identifiers);
+			}
+		}
+	}
+	//occasionally mutate a single character into an arbitrary printable one
+	if (!result.empty() && random() % 8 == 0) {
+		result[random() % result.size()] = static_cast<wchar_t>(L' ' + random() % 95);
+	}
+	return result;
+}
+
+static const std::vector<std::wstring> corpus = {
+	L"1.0.0", L"0.0.0", L"1.2.3", L"10.20.30", L"1.1.2-prerelease+meta", L"1.1.2+meta", L"1.1.2+meta-valid",
+	L"1.0.0-alpha", L"1.0.0-beta", L"1.0.0-alpha.beta", L"1.0.0-alpha.beta.1", L"1.0.0-alpha.1", L"1.0.0-alpha0.valid",
+	L"1.0.0-alpha.0valid", L"1.0.0-rc.1+build.1", L"2.0.0-rc.1+build.123", L"1.2.3-beta", L"10.2.3-DEV-SNAPSHOT",
+	L"1.2.3-SNAPSHOT-123", L"2.0.0+build.1848", L"2.0.1-alpha.1227", L"1.0.0-alpha+beta", L"1.2.3----RC-SNAPSHOT.12.9.1--.12+788",
+	L"1.2.3----R-S.12.9.1--.12+meta", L"1.2.3----RC-SNAPSHOT.12.9.1--.12", L"1.0.0+0.build.1-rc.10000aaa-kk-0.1",
+	L"18446744073709551615.0.0", L"1.0.0-0A.is.legal", L">=1.0.0", L">1.0.0", L"<=1.0.0", L"<1.0.0", L"^1.0.0",
+	L"1", L"1.2", L"1.2.3-0123", L"1.2.3-0123.0123", L"1.1.2+.123", L"+invalid", L"-invalid", L"-invalid+invalid",
+	L"-invalid.01", L"alpha", L"alpha.beta", L"alpha.beta.1", L"alpha.1", L"alpha+beta", L"alpha_beta", L"alpha.",
+	L"alpha..", L"beta", L"1.0.0-alpha_beta", L"-alpha.", L"1.0.0-alpha..", L"1.0.0-alpha..1", L"1.0.0-alpha...1",
+	L"01.1.1", L"1.01.1", L"1.1.01", L"1.2.3.DEV", L"1.2-SNAPSHOT", L"1.2.31.2.3----RC-SNAPSHOT.12.09.1--..12+788",
+	L"1.2-RC-SNAPSHOT", L"-1.0.3-gamma+b7718", L"+justmeta", L"9.8.7+meta+meta", L"9.8.7-whatever+meta+meta",
+	L"18446744073709551616.0.0", L"99999999999999999999999.999999999999999999.99999999999999999", L"", L" 1.0.0",
+	L"1.0.0 ", L"=1.0.0", L">=", L"^", L"<=<1.0.0", L">>1.0.0"
+};
+
+int main(int argc, char** argv) {
+	const uint64_t iterations = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 1000000;
+	const uint64_t seed = argc > 2 ? std::strtoull(argv[2], nullptr, 10) : 20240301;
+	std::mt19937_64 random(seed);
+
+	uint64_t mismatches = 0;
+	uint64_t validStrings = 0;
+	auto check = [&](const std::wstring& string) {
+		const VersionResult expected = parseWithRegex(string);
+		const VersionResult actual = parseWithParser(string);
+		validStrings += expected.valid ? 1 : 0;
+		if (!resultsEqual(expected, actual)) {
+			if (mismatches++ < 20) {
+				std::wcout << L"Mismatch on \"" << string << L"\": regex " << (expected.valid ? L"accepts" : L"rejects")
+					<< L", parser " << (actual.valid ? L"accepts" : L"rejects") << std::endl;
+			}
+		}
+	};
+	for (const std::wstring& string : corpus) {
+		check(string);
+	}
+	for (uint64_t i = 0; i < iterations; i++) {
+		check(generateVersionString(random));
+	}
+	const uint64_t total = corpus.size() + iterations;
+	std::wcout << L"Checked " << total << L" strings (" << validStrings << L" valid) with seed " << seed
+		<< L", " << mismatches << L" mismatches" << std::endl;
+	return mismatches == 0 ? 0 : 1;
+}